@@ -25,6 +25,7 @@ AAmmo::AAmmo()
 	AmmoCollisionSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AmmoCollisionSphere"));
 	AmmoCollisionSphere->SetupAttachment(GetRootComponent());
 	AmmoCollisionSphere->SetSphereRadius(50.0f);
+	AmmoCollisionSphere->SetCollisionProfileName(ItemCollisionProfile::Area);
 }
 
 void AAmmo::Tick(float DeltaTime)
@@ -59,68 +60,31 @@ void AAmmo::EndPlay(EEndPlayReason::Type Reason)
 			GetWorldTimerManager().ClearTimer(RespawnTimerHandle);
 		break;
 	}
+
+	Super::EndPlay(Reason);
 }
 
 void AAmmo::SetItemProperties(EItemState State)
 {
 	Super::SetItemProperties(State);
 
+	if (AmmoMesh == nullptr) return;
+
 	switch (State)
 	{
 	case EItemState::EIS_Pickup:
-
-		if (AmmoMesh)
-		{
-			AmmoMesh->SetSimulatePhysics(false);
-			AmmoMesh->SetEnableGravity(false);
-			AmmoMesh->SetVisibility(true);
-			AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		break;
-
 	case EItemState::EIS_EquipInterping:
-
-		if (AmmoMesh)
-		{
-			AmmoMesh->SetSimulatePhysics(false);
-			AmmoMesh->SetEnableGravity(false);
-			AmmoMesh->SetVisibility(true);
-			AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		break;
-
-	case EItemState::EIS_PickedUp:
-		break;
-
 	case EItemState::EIS_Equipped:
-
-		if (AmmoMesh)
-		{
-			AmmoMesh->SetSimulatePhysics(false);
-			AmmoMesh->SetEnableGravity(false);
-			AmmoMesh->SetVisibility(true);
-			AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
+		AmmoMesh->SetVisibility(true);
+		ApplyCollisionProfile(AmmoMesh, ItemCollisionProfile::NoCollision);
 		break;
 
 	case EItemState::EIS_Falling:
+		AmmoMesh->SetVisibility(true);
+		ApplyCollisionProfile(AmmoMesh, ItemCollisionProfile::Falling, true);
+		break;
 
-		if (AmmoMesh)
-		{
-			AmmoMesh->SetSimulatePhysics(true);
-			AmmoMesh->SetVisibility(true);
-			AmmoMesh->SetEnableGravity(true);
-			AmmoMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-			AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AmmoMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldStatic, ECollisionResponse::ECR_Block);
-		}
-
+	default:
 		break;
 	}
 }
@@ -148,32 +112,22 @@ void AAmmo::SetPickupState(EPickupState NewPickupState)
 	case EPickupState::EIT_Active:
 		if (AmmoMesh)
 		{
-			AmmoMesh->SetSimulatePhysics(false);
-			AmmoMesh->SetEnableGravity(false);
 			AmmoMesh->SetVisibility(true);
-			AmmoMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-			AmmoMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
-			AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
+			ApplyCollisionProfile(AmmoMesh, ItemCollisionProfile::BlockAll);
 		}
 
-		if (AmmoCollisionSphere)
-			AmmoCollisionSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		ApplyCollisionProfile(AmmoCollisionSphere, ItemCollisionProfile::Area);
 
 		break;
 
 	case EPickupState::EIT_Respawning:
 		if (AmmoMesh)
 		{
-			AmmoMesh->SetSimulatePhysics(false);
-			AmmoMesh->SetEnableGravity(false);
 			AmmoMesh->SetVisibility(false);
-			AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-			AmmoMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
-			AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+			ApplyCollisionProfile(AmmoMesh, ItemCollisionProfile::NoCollision);
 		}
 
-		if (AmmoCollisionSphere)
-			AmmoCollisionSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		ApplyCollisionProfile(AmmoCollisionSphere, ItemCollisionProfile::NoCollision);
 
 		GetWorldTimerManager().SetTimer(RespawnTimerHandle, FTimerDelegate::CreateLambda([&] 
 			{
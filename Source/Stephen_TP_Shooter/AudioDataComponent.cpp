@@ -1,4 +1,5 @@
 #include "AudioDataComponent.h"
+#include "AudioVoiceSubsystem.h"
 
 #include "Sound/SoundCue.h"
 #include "Components/AudioComponent.h"
@@ -12,27 +13,29 @@ UAudioDataComponent::UAudioDataComponent()
 void UAudioDataComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	SoundRegistry.Build(AudioMap);
+
+	AudioVoiceSubsystem = GetWorld()->GetSubsystem<UAudioVoiceSubsystem>();
 }
 
-void UAudioDataComponent::SetAudioComponentInstance(TObjectPtr<UAudioComponent> AudioComp)
+void UAudioDataComponent::PlayTheSound(const FString& SoundName, bool bFadeIn, bool bFadeOut, float VolumeMultiplier)
 {
-	if (AudioComp == nullptr) return;
+	if (AudioVoiceSubsystem == nullptr) return;
 
-	AudioCompInstance = AudioComp;
+	//Names outside ESoundType still resolve through the registry and play as Misc voices
+	const EVoiceCategory Category = UAudioVoiceSubsystem::GetCategoryForSound(FIndexedSoundRegistry::GetSoundType(SoundName));
+	AudioVoiceSubsystem->PlayActorSound(GetOwner(), SoundRegistry.Find(SoundName), Category, bFadeIn, bFadeOut, VolumeMultiplier);
 }
 
-void UAudioDataComponent::PlayTheSound(const FString& SoundName, bool bFadeIn, bool bFadeOut, float VolumeMultiplier)
+void UAudioDataComponent::PlayTheSound(ESoundType SoundType, bool bFadeIn, bool bFadeOut, float VolumeMultiplier)
 {
-	if (AudioCompInstance == nullptr || !AudioMap.Contains(SoundName) || AudioMap[SoundName] == nullptr) return;
-
-	auto Sound = AudioMap[SoundName];
-	AudioCompInstance->SetSound(Sound);
-	AudioCompInstance->SetVolumeMultiplier(VolumeMultiplier);
-
-	if (bFadeIn)
-		AudioCompInstance->FadeIn(0.5f);
-	else if (bFadeOut)
-		AudioCompInstance->FadeOut(0.5f, 1.0f);
-	else
-		AudioCompInstance->Play();
-}
\ No newline at end of file
+	if (AudioVoiceSubsystem == nullptr) return;
+
+	AudioVoiceSubsystem->PlayActorSound(GetOwner(), SoundRegistry.Get(SoundType), UAudioVoiceSubsystem::GetCategoryForSound(SoundType), bFadeIn, bFadeOut, VolumeMultiplier);
+}
+
+UAudioComponent* UAudioDataComponent::GetAudioComponent() const
+{
+	return AudioVoiceSubsystem ? AudioVoiceSubsystem->GetLatestVoiceOf(GetOwner()) : nullptr;
+}
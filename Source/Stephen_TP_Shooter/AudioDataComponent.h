@@ -4,10 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "IndexedSoundRegistry.h"
 #include "AudioDataComponent.generated.h"
 
 class UAudioComponent;
 class USoundCue;
+class UAudioVoiceSubsystem;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class STEPHEN_TP_SHOOTER_API UAudioDataComponent : public UActorComponent
@@ -25,12 +27,20 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Audio", meta = (AllowPrivateAccess = "true"))
 	TMap<FString, TObjectPtr<USoundCue>> AudioMap;
 
-	//Audio Component Instance
-	TObjectPtr<UAudioComponent> AudioCompInstance;
+	//AudioMap resolved by ESoundType at BeginPlay
+	FIndexedSoundRegistry SoundRegistry;
+
+	//Voices are started through the world's voice pool, the same as Enemies and the ShooterCharacter
+	UPROPERTY()
+	TObjectPtr<UAudioVoiceSubsystem> AudioVoiceSubsystem;
 
 public:
-	FORCEINLINE void SetAudioComponentInstance(TObjectPtr<UAudioComponent> AudioComp);
+	//Newest voice this component's owner started, null when none is playing
+	UFUNCTION(BlueprintCallable)
+	UAudioComponent* GetAudioComponent() const;
 
 	UFUNCTION(BlueprintCallable)
 	void PlayTheSound(const FString& SoundName, bool bFadeIn, bool bFadeOut, float VolumeMultiplier);
+
+	void PlayTheSound(ESoundType SoundType, bool bFadeIn, bool bFadeOut, float VolumeMultiplier);
 };
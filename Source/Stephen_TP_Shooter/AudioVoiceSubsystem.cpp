@@ -0,0 +1,355 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AudioVoiceSubsystem.h"
+#include "Stephen_TP_Shooter.h"
+
+#include "Components/AudioComponent.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Sound/SoundBase.h"
+
+DECLARE_CYCLE_STAT(TEXT("Audio Voice Tick"), STAT_AudioVoiceTick, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Audio Voices Active"), STAT_AudioVoicesActive, STATGROUP_GunBound);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Audio Voices Culled"), STAT_AudioVoicesCulled, STATGROUP_GunBound);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Audio Voices Stolen"), STAT_AudioVoicesStolen, STATGROUP_GunBound);
+
+UAudioVoiceSubsystem::UAudioVoiceSubsystem() :
+	MaxVoices(32),
+	PrewarmCount(16),
+	CulledVoiceCount(0),
+	NextVoiceSequence(0)
+{
+}
+
+void UAudioVoiceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (uint8 i = 0; i < (uint8)EVoiceCategory::EVC_MAX; i++)
+	{
+		ResolvedSettings[i] = FVoiceCategorySettings();
+		ResolvedSettings[i].Category = (EVoiceCategory)i;
+		CategoryVoiceCounts[i] = 0;
+	}
+
+	for (const FVoiceCategorySettings& Settings : CategorySettings)
+	{
+		if (Settings.Category >= EVoiceCategory::EVC_MAX) continue;
+
+		ResolvedSettings[(uint8)Settings.Category] = Settings;
+	}
+}
+
+void UAudioVoiceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (int32 i = FreeAudioComponents.Num(); i < PrewarmCount; i++)
+	{
+		if (UAudioComponent* AudioComponent = CreateAudioComponent())
+			FreeAudioComponents.Add(AudioComponent);
+	}
+}
+
+void UAudioVoiceSubsystem::Deinitialize()
+{
+	for (const FActiveVoice& Voice : ActiveVoices)
+	{
+		if (Voice.AudioComponent)
+			Voice.AudioComponent->Stop();
+	}
+
+	ActiveVoices.Empty();
+	FreeAudioComponents.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UAudioVoiceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAudioVoiceSubsystem, STATGROUP_Tickables);
+}
+
+UAudioVoiceSubsystem* UAudioVoiceSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (WorldContextObject == nullptr) return nullptr;
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UAudioVoiceSubsystem>() : nullptr;
+}
+
+UAudioComponent* UAudioVoiceSubsystem::SpawnVoiceAtLocation(const UObject* WorldContextObject, USoundBase* Sound, EVoiceCategory Category, const FVector& Location, float VolumeMultiplier)
+{
+	UAudioVoiceSubsystem* AudioVoiceSubsystem = Get(WorldContextObject);
+	return AudioVoiceSubsystem ? AudioVoiceSubsystem->PlaySoundAtLocation(Sound, Category, Location, VolumeMultiplier) : nullptr;
+}
+
+UAudioComponent* UAudioVoiceSubsystem::SpawnVoice2D(const UObject* WorldContextObject, USoundBase* Sound, EVoiceCategory Category, float VolumeMultiplier)
+{
+	UAudioVoiceSubsystem* AudioVoiceSubsystem = Get(WorldContextObject);
+	return AudioVoiceSubsystem ? AudioVoiceSubsystem->PlaySound2D(Sound, Category, VolumeMultiplier) : nullptr;
+}
+
+void UAudioVoiceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_AudioVoiceTick);
+
+	//Hand finished voices back to the pool
+	for (int32 i = ActiveVoices.Num() - 1; i >= 0; i--)
+	{
+		const UAudioComponent* AudioComponent = ActiveVoices[i].AudioComponent;
+		if (AudioComponent == nullptr || !AudioComponent->IsPlaying())
+			ReleaseVoiceAt(i);
+	}
+
+	SET_DWORD_STAT(STAT_AudioVoicesActive, ActiveVoices.Num());
+}
+
+UAudioComponent* UAudioVoiceSubsystem::PlaySoundAtLocation(USoundBase* Sound, EVoiceCategory Category, const FVector& Location, float VolumeMultiplier, bool bFadeIn, const UObject* Owner, USceneComponent* AttachTo)
+{
+	return StartVoice(Sound, Category, Location, false, VolumeMultiplier, bFadeIn, false, Owner, AttachTo);
+}
+
+UAudioComponent* UAudioVoiceSubsystem::PlaySound2D(USoundBase* Sound, EVoiceCategory Category, float VolumeMultiplier, const UObject* Owner)
+{
+	return StartVoice(Sound, Category, FVector::ZeroVector, true, VolumeMultiplier, false, false, Owner, nullptr);
+}
+
+UAudioComponent* UAudioVoiceSubsystem::PlayActorSound(AActor* Actor, USoundBase* Sound, EVoiceCategory Category, bool bFadeIn, bool bFadeOut, float VolumeMultiplier)
+{
+	if (Actor == nullptr) return nullptr;
+
+	return StartVoice(Sound, Category, Actor->GetActorLocation(), false, VolumeMultiplier, bFadeIn, bFadeOut, Actor, Actor->GetRootComponent());
+}
+
+void UAudioVoiceSubsystem::StopVoicesOf(const UObject* Owner, float FadeOutDuration)
+{
+	if (Owner == nullptr) return;
+
+	for (int32 i = ActiveVoices.Num() - 1; i >= 0; i--)
+	{
+		if (ActiveVoices[i].Owner.Get() == Owner)
+			ReleaseVoiceAt(i, FadeOutDuration);
+	}
+}
+
+UAudioComponent* UAudioVoiceSubsystem::GetLatestVoiceOf(const UObject* Owner) const
+{
+	if (Owner == nullptr) return nullptr;
+
+	//ReleaseVoiceAt swaps the last voice into the freed slot, so array order says nothing about age
+	const FActiveVoice* Latest = nullptr;
+	for (const FActiveVoice& Voice : ActiveVoices)
+	{
+		if (Voice.Owner.Get() == Owner && (Latest == nullptr || Voice.StartSequence > Latest->StartSequence))
+			Latest = &Voice;
+	}
+
+	return Latest ? Latest->AudioComponent : nullptr;
+}
+
+EVoiceCategory UAudioVoiceSubsystem::GetCategoryForSound(ESoundType SoundType)
+{
+	switch (SoundType)
+	{
+	case ESoundType::EST_HitSound:
+	case ESoundType::EST_HitHurtSound:
+	case ESoundType::EST_BulletHitSound:
+	case ESoundType::EST_DeathSound:
+	case ESoundType::EST_StunSound:
+		return EVoiceCategory::EVC_Hit;
+
+	case ESoundType::EST_AttackSound:
+	case ESoundType::EST_AxeSwingSound:
+		return EVoiceCategory::EVC_Attack;
+
+	case ESoundType::EST_GreetSound:
+		return EVoiceCategory::EVC_Greet;
+
+	case ESoundType::EST_KillTauntSound:
+		return EVoiceCategory::EVC_Taunt;
+
+	default:
+		return EVoiceCategory::EVC_Misc;
+	}
+}
+
+UAudioComponent* UAudioVoiceSubsystem::StartVoice(USoundBase* Sound, EVoiceCategory Category, const FVector& Location, bool b2D, float VolumeMultiplier, bool bFadeIn, bool bFadeOut, const UObject* Owner, USceneComponent* AttachTo)
+{
+	if (Sound == nullptr || Category >= EVoiceCategory::EVC_MAX) return nullptr;
+
+	const FVoiceCategorySettings& Settings = ResolvedSettings[(uint8)Category];
+	const FVector VoiceLocation = AttachTo ? AttachTo->GetComponentLocation() : Location;
+
+	//Distance cull against the listener, a voice nobody can hear never takes a slot
+	float DistanceScale = 1.0f;
+	FVector ListenerLocation;
+	if (!b2D && GetListenerLocation(ListenerLocation))
+	{
+		const float MaxDistance = Settings.MaxDistance > 0.0f ? Settings.MaxDistance : Sound->GetMaxDistance();
+		const float Distance = FVector::Dist(ListenerLocation, VoiceLocation);
+		if (Distance > MaxDistance)
+		{
+			CulledVoiceCount++;
+			INC_DWORD_STAT(STAT_AudioVoicesCulled);
+			return nullptr;
+		}
+
+		DistanceScale = 1.0f - Distance / FMath::Max(MaxDistance, 1.0f);
+	}
+
+	//Same owner and category replaces the previous voice, like the old per actor audio component
+	if (Owner)
+	{
+		for (int32 i = ActiveVoices.Num() - 1; i >= 0; i--)
+		{
+			if (ActiveVoices[i].Category == Category && ActiveVoices[i].Owner.Get() == Owner)
+				ReleaseVoiceAt(i);
+		}
+	}
+
+	const float Score = Settings.Priority * VolumeMultiplier * DistanceScale;
+	if (!MakeRoomForVoice(Category, Score))
+	{
+		CulledVoiceCount++;
+		INC_DWORD_STAT(STAT_AudioVoicesCulled);
+		return nullptr;
+	}
+
+	UAudioComponent* AudioComponent = AcquireAudioComponent();
+	if (AudioComponent == nullptr) return nullptr;
+
+	AudioComponent->bAllowSpatialization = !b2D;
+	AudioComponent->SetSound(Sound);
+	AudioComponent->SetVolumeMultiplier(VolumeMultiplier);
+
+	if (AttachTo)
+		AudioComponent->AttachToComponent(AttachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	else
+		AudioComponent->SetWorldLocation(VoiceLocation);
+
+	if (bFadeIn)
+	{
+		AudioComponent->FadeIn(0.5f);
+	}
+	else
+	{
+		AudioComponent->Play();
+		if (bFadeOut)
+			AudioComponent->FadeOut(0.5f, 1.0f);
+	}
+
+	FActiveVoice& Voice = ActiveVoices.AddDefaulted_GetRef();
+	Voice.AudioComponent = AudioComponent;
+	Voice.Owner = Owner;
+	Voice.Category = Category;
+	Voice.Score = Score;
+	Voice.StartSequence = NextVoiceSequence++;
+
+	CategoryVoiceCounts[(uint8)Category]++;
+	SET_DWORD_STAT(STAT_AudioVoicesActive, ActiveVoices.Num());
+
+	return AudioComponent;
+}
+
+bool UAudioVoiceSubsystem::MakeRoomForVoice(EVoiceCategory Category, float NewScore)
+{
+	const int32 CategoryMaxVoices = ResolvedSettings[(uint8)Category].MaxVoices;
+	if (CategoryMaxVoices > 0 && CategoryVoiceCounts[(uint8)Category] >= CategoryMaxVoices)
+	{
+		const int32 Lowest = FindLowestScoreVoice(Category, false);
+		if (Lowest == INDEX_NONE || ActiveVoices[Lowest].Score >= NewScore) return false;
+
+		ReleaseVoiceAt(Lowest);
+		INC_DWORD_STAT(STAT_AudioVoicesStolen);
+	}
+
+	if (MaxVoices > 0 && ActiveVoices.Num() >= MaxVoices)
+	{
+		const int32 Lowest = FindLowestScoreVoice(Category, true);
+		if (Lowest == INDEX_NONE || ActiveVoices[Lowest].Score >= NewScore) return false;
+
+		ReleaseVoiceAt(Lowest);
+		INC_DWORD_STAT(STAT_AudioVoicesStolen);
+	}
+
+	return true;
+}
+
+int32 UAudioVoiceSubsystem::FindLowestScoreVoice(EVoiceCategory Category, bool bAnyCategory) const
+{
+	int32 Lowest = INDEX_NONE;
+	for (int32 i = 0; i < ActiveVoices.Num(); i++)
+	{
+		if (!bAnyCategory && ActiveVoices[i].Category != Category) continue;
+
+		if (Lowest == INDEX_NONE || ActiveVoices[i].Score < ActiveVoices[Lowest].Score)
+			Lowest = i;
+	}
+
+	return Lowest;
+}
+
+UAudioComponent* UAudioVoiceSubsystem::AcquireAudioComponent()
+{
+	while (FreeAudioComponents.Num() > 0)
+	{
+		UAudioComponent* AudioComponent = FreeAudioComponents.Pop(false);
+		if (AudioComponent && AudioComponent->IsRegistered())
+			return AudioComponent;
+	}
+
+	return CreateAudioComponent();
+}
+
+UAudioComponent* UAudioVoiceSubsystem::CreateAudioComponent()
+{
+	UWorld* World = GetWorld();
+	AWorldSettings* WorldSettings = World ? World->GetWorldSettings() : nullptr;
+	if (WorldSettings == nullptr) return nullptr;
+
+	UAudioComponent* AudioComponent = NewObject<UAudioComponent>(WorldSettings);
+	AudioComponent->bAutoActivate = false;
+	AudioComponent->bAutoDestroy = false;
+	AudioComponent->bStopWhenOwnerDestroyed = false;
+	AudioComponent->RegisterComponentWithWorld(World);
+
+	return AudioComponent;
+}
+
+void UAudioVoiceSubsystem::ReleaseVoiceAt(int32 Index, float FadeOutDuration)
+{
+	FActiveVoice& Voice = ActiveVoices[Index];
+
+	//Fading voices keep their slot until they finish, only the owner link is dropped
+	if (FadeOutDuration > 0.0f && Voice.AudioComponent && Voice.AudioComponent->IsPlaying())
+	{
+		Voice.AudioComponent->FadeOut(FadeOutDuration, 0.0f);
+		Voice.Owner.Reset();
+		return;
+	}
+
+	if (UAudioComponent* AudioComponent = Voice.AudioComponent)
+	{
+		AudioComponent->Stop();
+		AudioComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+		FreeAudioComponents.Add(AudioComponent);
+	}
+
+	CategoryVoiceCounts[(uint8)Voice.Category]--;
+	ActiveVoices.RemoveAtSwap(Index, 1, false);
+}
+
+bool UAudioVoiceSubsystem::GetListenerLocation(FVector& OutLocation) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (PlayerController == nullptr) return false;
+
+	FVector FrontDir, RightDir;
+	PlayerController->GetAudioListenerPosition(OutLocation, FrontDir, RightDir);
+	return true;
+}
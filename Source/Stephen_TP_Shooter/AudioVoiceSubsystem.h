@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SoundType.h"
+#include "AudioVoiceSubsystem.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+class USceneComponent;
+class AActor;
+
+UENUM(BlueprintType)
+enum class EVoiceCategory : uint8
+{
+	EVC_Hit UMETA(DisplayName = "Hit"),
+	EVC_Attack UMETA(DisplayName = "Attack"),
+	EVC_Greet UMETA(DisplayName = "Greet"),
+	EVC_Taunt UMETA(DisplayName = "Taunt"),
+	EVC_Fire UMETA(DisplayName = "Fire"),
+	EVC_Explosion UMETA(DisplayName = "Explosion"),
+	EVC_Pickup UMETA(DisplayName = "Pickup"),
+	EVC_Misc UMETA(DisplayName = "Misc"),
+
+	EVC_MAX UMETA(DisplayName = "Default MAX")
+};
+
+USTRUCT()
+struct FVoiceCategorySettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config)
+	EVoiceCategory Category;
+
+	//Voices of this category playing at once, 0 means only the global limit applies
+	UPROPERTY(Config)
+	int32 MaxVoices;
+
+	//Weight used when choosing which voice to cull or steal
+	UPROPERTY(Config)
+	float Priority;
+
+	//Voices farther than this from the listener are never started, 0 uses the sound attenuation distance
+	UPROPERTY(Config)
+	float MaxDistance;
+
+	FVoiceCategorySettings()
+	{
+		Category = EVoiceCategory::EVC_Misc;
+		MaxVoices = 0;
+		Priority = 1.0f;
+		MaxDistance = 0.0f;
+	}
+};
+
+USTRUCT()
+struct FActiveVoice
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UAudioComponent> AudioComponent;
+
+	TWeakObjectPtr<const UObject> Owner;
+	EVoiceCategory Category;
+
+	//Priority * volume * distance falloff at start, lowest is stolen first
+	float Score;
+
+	//Order the voice started in, highest is the newest since releases reorder ActiveVoices
+	uint32 StartSequence;
+
+	FActiveVoice()
+	{
+		Category = EVoiceCategory::EVC_Misc;
+		Score = 0.0f;
+		StartSequence = 0;
+	}
+};
+
+/*
+* Plays every gameplay sound through a pool of audio components.
+* Before a voice starts it is culled by distance, per category concurrency and a global voice cap,
+* stealing the lowest scoring voice when the new one matters more.
+*/
+UCLASS(Config = Game)
+class STEPHEN_TP_SHOOTER_API UAudioVoiceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UAudioVoiceSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static UAudioVoiceSubsystem* Get(const UObject* WorldContextObject);
+
+	//Fire and forget replacements for UGameplayStatics::PlaySoundAtLocation and PlaySound2D
+	static UAudioComponent* SpawnVoiceAtLocation(const UObject* WorldContextObject, USoundBase* Sound, EVoiceCategory Category, const FVector& Location, float VolumeMultiplier = 1.0f);
+	static UAudioComponent* SpawnVoice2D(const UObject* WorldContextObject, USoundBase* Sound, EVoiceCategory Category, float VolumeMultiplier = 1.0f);
+
+	//Starts a voice at Location, following AttachTo when given. Owner keeps at most one voice per category, the older one is replaced
+	UAudioComponent* PlaySoundAtLocation(USoundBase* Sound, EVoiceCategory Category, const FVector& Location, float VolumeMultiplier = 1.0f, bool bFadeIn = false, const UObject* Owner = nullptr, USceneComponent* AttachTo = nullptr);
+
+	//Starts a non spatialized voice, never culled by distance
+	UAudioComponent* PlaySound2D(USoundBase* Sound, EVoiceCategory Category, float VolumeMultiplier = 1.0f, const UObject* Owner = nullptr);
+
+	//Voice owned by and attached to Actor, bFadeOut fades the new voice out over half a second like the old per actor audio component
+	UAudioComponent* PlayActorSound(AActor* Actor, USoundBase* Sound, EVoiceCategory Category, bool bFadeIn, bool bFadeOut, float VolumeMultiplier = 1.0f);
+
+	//Stops every voice started by Owner, fading out over FadeOutDuration when above zero
+	void StopVoicesOf(const UObject* Owner, float FadeOutDuration = 0.0f);
+
+	//Most recently started voice of Owner that is still playing, null when it has none
+	UAudioComponent* GetLatestVoiceOf(const UObject* Owner) const;
+
+	static EVoiceCategory GetCategoryForSound(ESoundType SoundType);
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetActiveVoiceCount() const { return ActiveVoices.Num(); }
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetCulledVoiceCount() const { return CulledVoiceCount; }
+
+private:
+	UAudioComponent* StartVoice(USoundBase* Sound, EVoiceCategory Category, const FVector& Location, bool b2D, float VolumeMultiplier, bool bFadeIn, bool bFadeOut, const UObject* Owner, USceneComponent* AttachTo);
+
+	//Frees a slot for a voice of Category with NewScore, false when the new voice should be culled instead
+	bool MakeRoomForVoice(EVoiceCategory Category, float NewScore);
+
+	int32 FindLowestScoreVoice(EVoiceCategory Category, bool bAnyCategory) const;
+
+	UAudioComponent* AcquireAudioComponent();
+	UAudioComponent* CreateAudioComponent();
+	void ReleaseVoiceAt(int32 Index, float FadeOutDuration = 0.0f);
+
+	bool GetListenerLocation(FVector& OutLocation) const;
+
+	//Total voices playing at once across every category
+	UPROPERTY(Config)
+	int32 MaxVoices;
+
+	//Audio components created when the world starts
+	UPROPERTY(Config)
+	int32 PrewarmCount;
+
+	UPROPERTY(Config)
+	TArray<FVoiceCategorySettings> CategorySettings;
+
+	//CategorySettings resolved by EVoiceCategory
+	FVoiceCategorySettings ResolvedSettings[(uint8)EVoiceCategory::EVC_MAX];
+	int32 CategoryVoiceCounts[(uint8)EVoiceCategory::EVC_MAX];
+
+	UPROPERTY()
+	TArray<FActiveVoice> ActiveVoices;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UAudioComponent>> FreeAudioComponents;
+
+	int32 CulledVoiceCount;
+
+	//StartSequence handed to the next voice
+	uint32 NextVoiceSequence;
+};
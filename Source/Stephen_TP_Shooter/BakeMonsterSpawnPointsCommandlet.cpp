@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BakeMonsterSpawnPointsCommandlet.h"
+#include "Stephen_TP_Shooter.h"
+#include "MonsterSpawnBakeData.h"
+#include "MonsterSpawnPoint.h"
+#include "ShooterCharacter.h"
+
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "Components/CapsuleComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+
+UBakeMonsterSpawnPointsCommandlet::UBakeMonsterSpawnPointsCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBakeMonsterSpawnPointsCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapPackageName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapPackageName))
+	{
+		UE_LOG(LogGunBound, Error, TEXT("Usage: -run=BakeMonsterSpawnPoints -Map=/Game/Path/To/Map [-Samples=256] [-Seed=1337]"));
+		return 1;
+	}
+
+	int32 SampleCount = 256;
+	int32 Seed = 1337;
+	FParse::Value(*Params, TEXT("Samples="), SampleCount);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	SampleCount = FMath::Max(SampleCount, 1);
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (World == nullptr)
+	{
+		UE_LOG(LogGunBound, Error, TEXT("Could not load map %s"), *MapPackageName);
+		return 1;
+	}
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Editor;
+
+	if (!World->bIsWorldInitialized)
+	{
+		UWorld::InitializationValues InitValues;
+		InitValues.RequiresHitProxies(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreateNavigation(true)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true);
+
+		World->InitWorld(InitValues);
+	}
+
+	World->UpdateWorldComponents(true, false);
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (NavSys && NavSys->GetDefaultNavDataInstance() == nullptr)
+		NavSys->Build();
+
+	ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	if (NavData == nullptr)
+	{
+		UE_LOG(LogGunBound, Error, TEXT("%s has no navmesh to sample"), *MapPackageName);
+		World->RemoveFromRoot();
+		return 1;
+	}
+
+	//Player eye height matches AMonsterSpawnPoint::GetVisibilityTrace, measured from the navmesh floor
+	const UCapsuleComponent* PlayerCapsule = GetDefault<AShooterCharacter>()->GetCapsuleComponent();
+	const float PlayerHalfHeight = PlayerCapsule ? PlayerCapsule->GetScaledCapsuleHalfHeight() : 88.0f;
+	const FVector EyeOffset(0.0f, 0.0f, PlayerHalfHeight * 1.75f);
+
+	//Samples come from the seeded stream rather than GetRandomPoint, which uses the global RNG, so a bake is reproducible
+	FRandomStream SampleStream(Seed);
+	const FBox NavBounds = NavData->GetBounds();
+	const FVector SampleExtent(100.0f, 100.0f, FMath::Max(NavBounds.GetExtent().Z, 100.0f));
+
+	TArray<FVector> PlayerSamples;
+	PlayerSamples.Reserve(SampleCount);
+
+	//Points that miss the navmesh are retried, up to a fixed number of attempts per sample
+	const int32 MaxAttempts = SampleCount * 16;
+	for (int32 Attempt = 0; Attempt < MaxAttempts && PlayerSamples.Num() < SampleCount; Attempt++)
+	{
+		const FVector Candidate(
+			SampleStream.FRandRange(NavBounds.Min.X, NavBounds.Max.X),
+			SampleStream.FRandRange(NavBounds.Min.Y, NavBounds.Max.Y),
+			NavBounds.GetCenter().Z);
+
+		FNavLocation SampleLocation;
+		if (NavSys->ProjectPointToNavigation(Candidate, SampleLocation, SampleExtent, NavData))
+			PlayerSamples.Add(SampleLocation.Location);
+	}
+
+	if (PlayerSamples.IsEmpty())
+	{
+		UE_LOG(LogGunBound, Error, TEXT("Failed to sample any player positions on %s"), *MapPackageName);
+		World->RemoveFromRoot();
+		return 1;
+	}
+
+	const FString BakePackageName = UMonsterSpawnBakeData::GetPackageNameForMap(MapPackageName);
+	const FString BakeAssetName = FPackageName::GetShortName(BakePackageName);
+
+	UPackage* BakePackage = CreatePackage(*BakePackageName);
+	BakePackage->FullyLoad();
+
+	UMonsterSpawnBakeData* BakeData = FindObject<UMonsterSpawnBakeData>(BakePackage, *BakeAssetName);
+	if (BakeData == nullptr)
+		BakeData = NewObject<UMonsterSpawnBakeData>(BakePackage, *BakeAssetName, RF_Public | RF_Standalone);
+
+	BakeData->SampleCount = PlayerSamples.Num();
+	BakeData->SpawnPoints.Reset();
+
+	const FVector ProjectExtent(200.0f, 200.0f, 300.0f);
+
+	for (TActorIterator<AMonsterSpawnPoint> It(World); It; ++It)
+	{
+		AMonsterSpawnPoint* SpawnPoint = *It;
+
+		FMonsterSpawnPointBakeEntry Entry;
+		Entry.SpawnPointName = SpawnPoint->GetFName();
+
+		const FVector SpawnLocation = SpawnPoint->GetActorLocation();
+
+		FNavLocation SpawnNavLocation;
+		Entry.bOnNavMesh = NavSys->ProjectPointToNavigation(SpawnLocation, SpawnNavLocation, ProjectExtent, NavData);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BakeSpawnPointVisibility));
+		QueryParams.AddIgnoredActor(SpawnPoint);
+
+		int32 VisibleCount = 0;
+		int32 ReachableCount = 0;
+
+		for (const FVector& PlayerSample : PlayerSamples)
+		{
+			FHitResult HitResult;
+			if (!World->LineTraceSingleByChannel(HitResult, SpawnLocation, PlayerSample + EyeOffset, ECollisionChannel::ECC_Pawn, QueryParams))
+				VisibleCount++;
+
+			if (Entry.bOnNavMesh)
+			{
+				FPathFindingQuery PathQuery(nullptr, *NavData, SpawnNavLocation.Location, PlayerSample);
+				if (NavSys->TestPathSync(PathQuery))
+					ReachableCount++;
+			}
+		}
+
+		Entry.VisibilityRatio = (float)VisibleCount / (float)PlayerSamples.Num();
+		Entry.ReachableRatio = (float)ReachableCount / (float)PlayerSamples.Num();
+		BakeData->SpawnPoints.Add(Entry);
+
+		UE_LOG(LogGunBound, Display, TEXT("%s: visible %.2f, reachable %.2f%s"), *Entry.SpawnPointName.ToString(), Entry.VisibilityRatio, Entry.ReachableRatio, Entry.bOnNavMesh ? TEXT("") : TEXT(" (off navmesh)"));
+	}
+
+	BakeData->RebuildLookup();
+	BakePackage->MarkPackageDirty();
+
+	const FString BakeFileName = FPackageName::LongPackageNameToFilename(BakePackageName, FPackageName::GetAssetPackageExtension());
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError;
+	const bool bSaved = UPackage::SavePackage(BakePackage, BakeData, *BakeFileName, SaveArgs);
+
+	World->RemoveFromRoot();
+
+	if (!bSaved)
+	{
+		UE_LOG(LogGunBound, Error, TEXT("Failed to save %s"), *BakeFileName);
+		return 1;
+	}
+
+	UE_LOG(LogGunBound, Display, TEXT("Baked %d spawn points from %d samples into %s"), BakeData->SpawnPoints.Num(), PlayerSamples.Num(), *BakePackageName);
+	return 0;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BakeMonsterSpawnPointsCommandlet.generated.h"
+
+/*
+* Samples player positions across a map's navmesh and bakes per spawn point visibility and reachability.
+* Editor only, run with:
+* UnrealEditor-Cmd GunBound.uproject -run=BakeMonsterSpawnPoints -Map=/Game/_Game/Maps/Level_Village [-Samples=256] [-Seed=1337]
+*/
+UCLASS()
+class STEPHEN_TP_SHOOTER_API UBakeMonsterSpawnPointsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBakeMonsterSpawnPointsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
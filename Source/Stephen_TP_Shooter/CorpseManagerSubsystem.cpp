@@ -0,0 +1,267 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CorpseManagerSubsystem.h"
+#include "Stephen_TP_Shooter.h"
+#include "Enemy.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "PhysicsEngine/BodyInstance.h"
+
+DECLARE_CYCLE_STAT(TEXT("Corpse Manager Tick"), STAT_CorpseManagerTick, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corpses Queued"), STAT_CorpsesQueued, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corpses Simulating"), STAT_CorpsesSimulating, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corpses Sleeping"), STAT_CorpsesSleeping, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corpses Frozen"), STAT_CorpsesFrozen, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ragdoll Bodies Awake"), STAT_RagdollBodiesAwake, STATGROUP_GunBound);
+
+UCorpseManagerSubsystem::UCorpseManagerSubsystem() :
+	MaxSimulatingRagdolls(6),
+	MaxSimulationTime(1.5f),
+	MaxQueueTime(0.2f),
+	SleepToFreezeTime(1.0f),
+	FreezeDistance(4000.0f),
+	ViewLocation(FVector::ZeroVector),
+	bHasViewLocation(false),
+	NumSimulating(0),
+	NumQueued(0)
+{
+}
+
+void UCorpseManagerSubsystem::Deinitialize()
+{
+	Corpses.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UCorpseManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCorpseManagerSubsystem, STATGROUP_Tickables);
+}
+
+void UCorpseManagerSubsystem::RegisterCorpse(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	UnregisterCorpse(Enemy);
+
+	FCorpseEntry& Entry = Corpses.AddDefaulted_GetRef();
+	Entry.Enemy = Enemy;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	Entry.StateTime = Now;
+
+	//Start in the same frame when there is room, so the death does not visibly hitch
+	if (NumSimulating < MaxSimulatingRagdolls && GetDistanceSqToView(Entry) <= FMath::Square(FreezeDistance))
+	{
+		StartSimulating(Entry, Now);
+		NumSimulating++;
+	}
+	else
+		NumQueued++;
+}
+
+void UCorpseManagerSubsystem::UnregisterCorpse(AEnemy* Enemy)
+{
+	for (int32 i = 0; i < Corpses.Num(); i++)
+	{
+		if (Corpses[i].Enemy != Enemy) continue;
+
+		if (Corpses[i].State == ECorpseState::ECS_Simulating) NumSimulating--;
+		else if (Corpses[i].State == ECorpseState::ECS_Queued) NumQueued--;
+
+		Corpses.RemoveAt(i, 1, false);
+		return;
+	}
+}
+
+void UCorpseManagerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_CorpseManagerTick);
+
+	if (Corpses.Num() == 0)
+	{
+		NumSimulating = 0;
+		NumQueued = 0;
+		return;
+	}
+
+	bHasViewLocation = false;
+	if (APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0))
+	{
+		ViewLocation = CameraManager->GetCameraLocation();
+		bHasViewLocation = true;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float FreezeDistanceSq = FMath::Square(FreezeDistance);
+
+	//Retire settled, old and far ragdolls first so their slots can be handed to the queue
+	int32 Simulating = 0;
+	int32 Sleeping = 0;
+	int32 Frozen = 0;
+	int32 BodiesAwake = 0;
+
+	for (int32 i = Corpses.Num() - 1; i >= 0; i--)
+	{
+		FCorpseEntry& Entry = Corpses[i];
+		AEnemy* Enemy = Entry.Enemy.Get();
+		if (Enemy == nullptr)
+		{
+			Corpses.RemoveAt(i, 1, false);
+			continue;
+		}
+
+		const float DistanceSq = GetDistanceSqToView(Entry);
+		const double StateAge = Now - Entry.StateTime;
+
+		switch (Entry.State)
+		{
+		case ECorpseState::ECS_Simulating:
+			if (StateAge >= MaxSimulationTime || DistanceSq > FreezeDistanceSq || !Enemy->GetMesh()->IsAnyRigidBodyAwake())
+				Retire(Entry, Now, DistanceSq);
+			break;
+
+		case ECorpseState::ECS_Sleeping:
+			if (StateAge >= SleepToFreezeTime || DistanceSq > FreezeDistanceSq)
+				Freeze(Entry, Now);
+			break;
+
+		default:
+			break;
+		}
+
+		switch (Entry.State)
+		{
+		case ECorpseState::ECS_Simulating:	Simulating++;	break;
+		case ECorpseState::ECS_Sleeping:	Sleeping++;		break;
+		case ECorpseState::ECS_Frozen:		Frozen++;		break;
+		default:											break;
+		}
+	}
+
+	//Hand free slots to the queue, oldest first
+	int32 Queued = 0;
+	for (FCorpseEntry& Entry : Corpses)
+	{
+		if (Entry.State != ECorpseState::ECS_Queued) continue;
+
+		if (GetDistanceSqToView(Entry) > FreezeDistanceSq)
+		{
+			Freeze(Entry, Now);
+			Frozen++;
+			continue;
+		}
+
+		//Waited too long, take the slot of the oldest simulating ragdoll
+		if (Simulating >= MaxSimulatingRagdolls && Now - Entry.StateTime > MaxQueueTime)
+		{
+			for (FCorpseEntry& Oldest : Corpses)
+			{
+				if (Oldest.State != ECorpseState::ECS_Simulating) continue;
+
+				Retire(Oldest, Now, GetDistanceSqToView(Oldest));
+				if (Oldest.State == ECorpseState::ECS_Sleeping)
+					Sleeping++;
+				else
+					Frozen++;
+
+				Simulating--;
+				break;
+			}
+		}
+
+		if (Simulating < MaxSimulatingRagdolls)
+		{
+			StartSimulating(Entry, Now);
+			Simulating++;
+		}
+		else
+			Queued++;
+	}
+
+	for (const FCorpseEntry& Entry : Corpses)
+	{
+		if (Entry.State != ECorpseState::ECS_Simulating) continue;
+
+		if (const AEnemy* Enemy = Entry.Enemy.Get())
+		{
+			for (const FBodyInstance* Body : Enemy->GetMesh()->Bodies)
+			{
+				if (Body && Body->IsInstanceAwake())
+					BodiesAwake++;
+			}
+		}
+	}
+
+	NumSimulating = Simulating;
+	NumQueued = Queued;
+
+	SET_DWORD_STAT(STAT_CorpsesQueued, Queued);
+	SET_DWORD_STAT(STAT_CorpsesSimulating, Simulating);
+	SET_DWORD_STAT(STAT_CorpsesSleeping, Sleeping);
+	SET_DWORD_STAT(STAT_CorpsesFrozen, Frozen);
+	SET_DWORD_STAT(STAT_RagdollBodiesAwake, BodiesAwake);
+}
+
+void UCorpseManagerSubsystem::StartSimulating(FCorpseEntry& Entry, double Now)
+{
+	Entry.State = ECorpseState::ECS_Simulating;
+	Entry.StateTime = Now;
+
+	if (AEnemy* Enemy = Entry.Enemy.Get())
+		Enemy->StartRagdoll();
+}
+
+void UCorpseManagerSubsystem::PutToSleep(FCorpseEntry& Entry, double Now)
+{
+	Entry.State = ECorpseState::ECS_Sleeping;
+	Entry.StateTime = Now;
+
+	if (AEnemy* Enemy = Entry.Enemy.Get())
+		Enemy->GetMesh()->PutAllRigidBodiesToSleep();
+}
+
+void UCorpseManagerSubsystem::Freeze(FCorpseEntry& Entry, double Now)
+{
+	Entry.State = ECorpseState::ECS_Frozen;
+	Entry.StateTime = Now;
+
+	AEnemy* Enemy = Entry.Enemy.Get();
+	if (Enemy == nullptr) return;
+
+	//The budget allocator would turn the mesh tick back on, so the corpse leaves it first
+	Enemy->SetAnimationBudgeted(false);
+
+	//Without a mesh tick the bones keep their last pose, whether it came from the ragdoll or the animation
+	USkeletalMeshComponent* Mesh = Enemy->GetMesh();
+	Mesh->PutAllRigidBodiesToSleep();
+	Mesh->SetAllBodiesSimulatePhysics(false);
+	Mesh->SetComponentTickEnabled(false);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+}
+
+void UCorpseManagerSubsystem::Retire(FCorpseEntry& Entry, double Now, float DistanceSq)
+{
+	//A retired ragdoll no longer needs its never-skip slot in the animation budget
+	if (AEnemy* Enemy = Entry.Enemy.Get())
+		Enemy->SetAnimationBudgeted(false);
+
+	if (DistanceSq > FMath::Square(FreezeDistance))
+		Freeze(Entry, Now);
+	else
+		PutToSleep(Entry, Now);
+}
+
+float UCorpseManagerSubsystem::GetDistanceSqToView(const FCorpseEntry& Entry) const
+{
+	const AEnemy* Enemy = Entry.Enemy.Get();
+	if (Enemy == nullptr || !bHasViewLocation) return 0.0f;
+
+	return FVector::DistSquared(ViewLocation, Enemy->GetMesh()->GetComponentLocation());
+}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CorpseManagerSubsystem.generated.h"
+
+class AEnemy;
+
+UENUM()
+enum class ECorpseState : uint8
+{
+	ECS_Queued		UMETA(DisplayName = "Queued"),
+	ECS_Simulating	UMETA(DisplayName = "Simulating"),
+	ECS_Sleeping	UMETA(DisplayName = "Sleeping"),
+	ECS_Frozen		UMETA(DisplayName = "Frozen"),
+
+	ECS_MAX			UMETA(DisplayName = "DefaultMAX")
+};
+
+struct FCorpseEntry
+{
+	TWeakObjectPtr<AEnemy> Enemy;
+	ECorpseState State;
+
+	//World time the corpse entered its current state
+	double StateTime;
+
+	FCorpseEntry()
+	{
+		State = ECorpseState::ECS_Queued;
+		StateTime = 0.0;
+	}
+};
+
+/*
+* Budgets ragdoll physics for dead Enemies.
+* At most MaxSimulatingRagdolls simulate at once, the rest wait in a queue. Ragdolls that have settled, aged out
+* or are far from the camera are put to sleep or frozen into their current pose.
+*/
+UCLASS(Config = Game)
+class STEPHEN_TP_SHOOTER_API UCorpseManagerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UCorpseManagerSubsystem();
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	//Starts the Enemy ragdoll right away if there is budget, otherwise queues it
+	void RegisterCorpse(AEnemy* Enemy);
+
+	//Forgets the corpse, its mesh is restored by the Enemy itself
+	void UnregisterCorpse(AEnemy* Enemy);
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetSimulatingCount() const { return NumSimulating; }
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetQueuedCount() const { return NumQueued; }
+
+private:
+	void StartSimulating(FCorpseEntry& Entry, double Now);
+	void PutToSleep(FCorpseEntry& Entry, double Now);
+	void Freeze(FCorpseEntry& Entry, double Now);
+
+	//Sleeps the corpse when near the camera, freezes it when far
+	void Retire(FCorpseEntry& Entry, double Now, float DistanceSq);
+
+	float GetDistanceSqToView(const FCorpseEntry& Entry) const;
+
+	//Max ragdolls simulating at the same time
+	UPROPERTY(Config)
+	int32 MaxSimulatingRagdolls;
+
+	//Seconds a ragdoll simulates before it is put to sleep
+	UPROPERTY(Config)
+	float MaxSimulationTime;
+
+	//Seconds a corpse may wait in the queue before the oldest simulating ragdoll is retired to make room
+	UPROPERTY(Config)
+	float MaxQueueTime;
+
+	//Seconds a sleeping ragdoll stays physical before being frozen
+	UPROPERTY(Config)
+	float SleepToFreezeTime;
+
+	//Corpses farther than this from the camera never simulate, and simulating ones are frozen
+	UPROPERTY(Config)
+	float FreezeDistance;
+
+	//Oldest first
+	TArray<FCorpseEntry> Corpses;
+
+	FVector ViewLocation;
+	bool bHasViewLocation;
+
+	int32 NumSimulating;
+	int32 NumQueued;
+};
@@ -4,13 +4,22 @@
 #include "Enemy.h"
 #include "IShooterActions.h"
 #include "EnemyController.h"
+#include "EnemyBehaviorTreeComponent.h"
 #include "EnemyManagerSubsystem.h"
+#include "CorpseManagerSubsystem.h"
+#include "AudioVoiceSubsystem.h"
+#include "FXPoolSubsystem.h"
 #include "SoundsDataAsset.h"
 #include "ShooterCharacter.h"
 #include "HealthComponent.h"
 #include "InventoryComponent.h"
 #include "ShooterGameState.h"
+#include "ShooterPlayerController.h"
+#include "HitNumberComponent.h"
 #include "Weapon.h"
+#include "RandomStreamSubsystem.h"
+#include "HitZoneDataAsset.h"
+#include "Stephen_TP_Shooter.h"
 
 #include "DrawDebugHelpers.h"
 #include "Engine/SkeletalMeshSocket.h"
@@ -18,17 +27,21 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Sound/SoundCue.h"
 #include "Particles/ParticleSystemComponent.h"
-#include "Blueprint/UserWidget.h"
-#include "BehaviorTree/BlackboardComponent.h"
+#include "BrainComponent.h"
 #include "GameFramework/PlayerState.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
 
 #include "Components/SphereComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/BoxComponent.h"
-#include "Components/AudioComponent.h"
+#include "Blueprint/UserWidget.h"
 
 // Sets default values
-AEnemy::AEnemy() :
+AEnemy::AEnemy(const FObjectInitializer& ObjectInitializer) :
+	//Budgeted mesh lets the animation budget allocator throttle and interpolate distant Enemies
+	Super(ObjectInitializer.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName)),
 	HealthBarDisplayTime(4.0f),
 	bCanHitReact(true),
 	HitReactTimeMin(0.5f),
@@ -40,14 +53,18 @@ AEnemy::AEnemy() :
 	bAttacking(false),
 	BaseDamage(20.0f),
 	LeftWeaponSocket(TEXT("FX_Trail_L_01")),
-	RightWeaponSocket(TEXT("FX_Trail_R_01"))
+	RightWeaponSocket(TEXT("FX_Trail_R_01")),
+	bPooled(false),
+	MeshAnimTickOption(EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones)
 {
- 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	//Hit numbers are drawn by the player's UHitNumberComponent, the Enemy only ticks while StoreHitNumber widgets are on screen
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	//Create Combat Range Sphere
 	CombatRangeSphere = CreateDefaultSubobject<USphereComponent>(TEXT("CombatRangeSphere"));
 	CombatRangeSphere->SetupAttachment(GetRootComponent());
+	CombatRangeSphere->SetCollisionResponseToChannel(ECC_WeaponTrace, ECollisionResponse::ECR_Ignore);
 
 	LeftWeaponCollisionBox = CreateDefaultSubobject<UBoxComponent>(TEXT("WeaponLeftBox"));
 	LeftWeaponCollisionBox->SetupAttachment(GetMesh(), TEXT("LeftWeaponBone"));
@@ -57,9 +74,6 @@ AEnemy::AEnemy() :
 
 	HealthComponent = CreateDefaultSubobject<UHealthComponent>(TEXT("EnemyHealthComponent"));
 
-	AudioComponent = CreateDefaultSubobject<UAudioComponent>(TEXT("EnemyAudioComponent"));
-	AudioComponent->SetupAttachment(GetRootComponent());
-
 	AttackSectionNames[0] = TEXT("Attack_L");
 	AttackSectionNames[1] = TEXT("Attack_R");
 	AttackSectionNames[2] = TEXT("Attack_L_Fast");
@@ -75,8 +89,16 @@ void AEnemy::BeginPlay()
 	ShooterGameState->OnSurvivalStartDelegate.AddDynamic(this, &AEnemy::OnMatchStart);
 	ShooterGameState->OnSurvivalEndDelegate.AddDynamic(this, &AEnemy::OnMatchEnd);
 
+	//Pooled Enemies broadcast their spawn when activated from the pool
 	EnemyManager = ShooterGameState->GetEnemyManager();
-	EnemyManager->OnEnemySpawnDelegate.Broadcast(this);
+	if (!bPooled)
+		EnemyManager->NotifyEnemySpawned(this);
+
+	CorpseManager = GetWorld()->GetSubsystem<UCorpseManagerSubsystem>();
+	AudioVoiceSubsystem = GetWorld()->GetSubsystem<UAudioVoiceSubsystem>();
+
+	if (UFXPoolSubsystem* FXPool = UFXPoolSubsystem::Get(this))
+		FXPool->PrewarmEffect(ImpactParticles, EFXCategory::EFXC_Impact);
 
 	//AgroSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AgroSphereOverlap);
 	CombatRangeSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::CombatRangeSphereOverlapBegin);
@@ -101,14 +123,28 @@ void AEnemy::BeginPlay()
 	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
 	GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
 
+	//Weapon traces pass the capsule and hit the physics asset bodies of the mesh
+	GetMesh()->SetCollisionResponseToChannel(ECC_WeaponTrace, ECollisionResponse::ECR_Block);
+	GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_WeaponTrace, ECollisionResponse::ECR_Ignore);
+
+	HeadBoneName = FName(*HeadBone);
+
+	//The first Enemy of this type to begin play builds the body to zone table for its physics asset
+	if (HitZoneDataAsset)
+		HitZoneDataAsset->CacheBodyZones(GetMesh()->GetPhysicsAsset(), HeadBoneName);
+
+	MeshRelativeTransform = GetMesh()->GetRelativeTransform();
+	MeshCollisionProfileName = GetMesh()->GetCollisionProfileName();
+	MeshAnimTickOption = GetMesh()->VisibilityBasedAnimTickOption;
+
 	//Get the AI Controller
 	const FVector WorldPatrolPoint = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPoint);
 	const FVector WorldPatrolPoint2 = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPoint2);
 
 	if (EnemyController = Cast<AEnemyController>(GetController()))
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsVector(TEXT("PatrolPoint"), WorldPatrolPoint);
-		EnemyController->GetBlackboardComponent()->SetValueAsVector(TEXT("PatrolPoint2"), WorldPatrolPoint2);
+		EnemyController->SetBlackboardVector(EnemyController->GetBlackboardKeys().PatrolPoint, WorldPatrolPoint);
+		EnemyController->SetBlackboardVector(EnemyController->GetBlackboardKeys().PatrolPoint2, WorldPatrolPoint2);
 		EnemyController->RunBehaviorTree(BehaviorTree);
 	}
 
@@ -139,34 +175,142 @@ void AEnemy::OnDeath(AActor* InstigatorActor, AController* InstigatorController)
 
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-	GetMesh()->SetAllBodiesSimulatePhysics(true);
-	GetMesh()->SetSimulatePhysics(true);
-	GetMesh()->SetAllBodiesPhysicsBlendWeight(1.0f);
-	GetMesh()->SetCollisionProfileName(TEXT("Ragdoll"));
-	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
+	//Ragdolls are budgeted, so the corpse may hold its last pose until a physics slot frees up
+	if (CorpseManager)
+		CorpseManager->RegisterCorpse(this);
+	else
+		StartRagdoll();
 
 	GetMesh()->HideBoneByName(FName("weapon_l"), EPhysBodyOp::PBO_None);
 	GetMesh()->HideBoneByName(FName("weapon_r"), EPhysBodyOp::PBO_None);
 
-	PlayTheSound("DeathSound", false, false, 1.0f);
+	PlayTheSound(ESoundType::EST_DeathSound, false, false, 1.0f);
 
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("Dead"), true);
+		EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().Dead, true);
 		EnemyController->StopMovement();
 	}
 
-	EnemyManager->OnEnemyDeathDelegate.Broadcast(this);
+	if (EnemyManager)
+		EnemyManager->NotifyEnemyDeath(this);
 
 	GetWorldTimerManager().SetTimer(DestroyTimerHandle, FTimerDelegate::CreateLambda([&]
 		{
-			Destroy();
+			if (EnemyManager)
+				EnemyManager->ReleaseEnemy(this);
+			else
+				Destroy();
 		}), 2.0f, false);
 }
 
+void AEnemy::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	SetAnimationBudgeted(true);
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
+
+	if (EnemyController)
+	{
+		const FVector WorldPatrolPoint = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPoint);
+		const FVector WorldPatrolPoint2 = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPoint2);
+
+		EnemyController->SetBlackboardVector(EnemyController->GetBlackboardKeys().PatrolPoint, WorldPatrolPoint);
+		EnemyController->SetBlackboardVector(EnemyController->GetBlackboardKeys().PatrolPoint2, WorldPatrolPoint2);
+		EnemyController->RunBehaviorTree(BehaviorTree);
+	}
+
+	if (EnemyManager)
+		EnemyManager->NotifyEnemySpawned(this);
+}
+
+void AEnemy::DeactivateToPool()
+{
+	//Lambda timers are not bound to this object, so clear them by handle
+	GetWorldTimerManager().ClearTimer(HeathBarHideTimerHandle);
+	GetWorldTimerManager().ClearTimer(HitReactTimer);
+	GetWorldTimerManager().ClearTimer(DestroyTimerHandle);
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	//Their DestroyHitNumber timers were just cleared, so remove any StoreHitNumber widgets now
+	for (auto& HitPairs : HitNumbersMap)
+	{
+		if (HitPairs.Key)
+			HitPairs.Key->RemoveFromParent();
+	}
+	HitNumbersMap.Empty();
+	SetActorTickEnabled(false);
+
+	if (EnemyManager)
+		EnemyManager->UnregisterEnemy(this);
+
+	if (CorpseManager)
+		CorpseManager->UnregisterCorpse(this);
+
+	HideHealthBarEvent();
+
+	if (EnemyController)
+	{
+		if (EnemyController->GetBrainComponent())
+			EnemyController->GetBrainComponent()->StopLogic(TEXT("Pooled"));
+
+		EnemyController->StopMovement();
+		EnemyController->ResetBlackboard();
+	}
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+		AnimInstance->StopAllMontages(0.0f);
+
+	//Undo the Ragdoll from OnDeath, a frozen corpse also had its mesh tick turned off
+	SetAnimationBudgeted(false);
+	GetMesh()->SetComponentTickEnabled(true);
+	GetMesh()->SetAllBodiesSimulatePhysics(false);
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetAllBodiesPhysicsBlendWeight(0.0f);
+	GetMesh()->SetCollisionProfileName(MeshCollisionProfileName);
+	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
+	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
+	GetMesh()->SetCollisionResponseToChannel(ECC_WeaponTrace, ECollisionResponse::ECR_Block);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	GetMesh()->SetRelativeTransform(MeshRelativeTransform);
+
+	GetMesh()->UnHideBoneByName(FName("weapon_l"));
+	GetMesh()->UnHideBoneByName(FName("weapon_r"));
+
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	LeftWeaponCollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RightWeaponCollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	if (AudioVoiceSubsystem)
+		AudioVoiceSubsystem->StopVoicesOf(this);
+
+	if (HealthComponent)
+		HealthComponent->ResetHealth();
+
+	const AEnemy* EnemyDefaults = GetClass()->GetDefaultObject<AEnemy>();
+	bGreetedPlayer = false;
+	bCanHitReact = true;
+	bStunned = false;
+	bCanMove = EnemyDefaults->bCanMove;
+	bInAttackRange = EnemyDefaults->bInAttackRange;
+	bAttacking = EnemyDefaults->bAttacking;
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+}
+
 void AEnemy::OnMatchStart()
 {
 	if (!ShooterGameState || !ShooterGameState->GetShooterCharacter()) return;	
+	if (bPooled && IsHidden()) return;
 
 	DetectPlayer(ShooterGameState->GetShooterCharacter());
 }
@@ -187,19 +331,19 @@ void AEnemy::PlayHitMontage(FName MontageSection, float PlayRate)
 		}
 
 		bCanHitReact = false;
-		const float HitReactTime = FMath::FRandRange(HitReactTimeMin, HitReactTimeMax);
+		const float HitReactTime = URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::AIStream).FRandRange(HitReactTimeMin, HitReactTimeMax);
 		GetWorldTimerManager().SetTimer(HitReactTimer, FTimerDelegate::CreateLambda([&]
 			{
 				bCanHitReact = true;
 			}), HitReactTime, false);
 
-		PlayTheSound("HitSound", true, false, 1.0f);
+		PlayTheSound(ESoundType::EST_HitSound, true, false, 1.0f);
 	}
 }
 
 FName AEnemy::GetAttackSectionName_Implementation()
 {
-	return AttackSectionNames[FMath::RandRange(0, 3)];
+	return AttackSectionNames[URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::AIStream).RandRange(0, 3)];
 }
 
 void AEnemy::PlayAttack_Implementation(FName MontageSection, float PlayRate)
@@ -213,23 +357,34 @@ void AEnemy::PlayAttack_Implementation(FName MontageSection, float PlayRate)
 		AnimInstance->Montage_JumpToSection(MontageSection, AttackMontage);
 	}
 
-	PlayTheSound("AttackSound", false, false, 1.0f);
-	PlayTheSound("AxeSwingSound", false, false, 1.0f);
+	PlayTheSound(ESoundType::EST_AttackSound, false, false, 1.0f);
+	PlayTheSound(ESoundType::EST_AxeSwingSound, false, false, 1.0f);
 }
 
 bool AEnemy::IsTargetDead_Implementation()
 {
 	if (EnemyController == nullptr) return false;
 
-	if (auto ShooterTarget = Cast<IShooterActions>(EnemyController->GetBlackboardComponent()->GetValueAsObject("Target")))
+	if (auto ShooterTarget = Cast<IShooterActions>(EnemyController->GetBlackboardObject(EnemyController->GetBlackboardKeys().Target)))
 		return ShooterTarget->HasDied_Implementation();
 
 	return false;
 }
 
+void AEnemy::ShowHitNumber_Implementation(int32 DamageToShow, FVector HitLocation, bool bHeadshot)
+{
+	AShooterPlayerController* PlayerController = Cast<AShooterPlayerController>(UGameplayStatics::GetPlayerController(this, 0));
+	if (PlayerController == nullptr || PlayerController->GetHitNumberComponent() == nullptr) return;
+
+	PlayerController->GetHitNumberComponent()->AddHitNumber(this, DamageToShow, HitLocation, bHeadshot);
+}
+
 void AEnemy::StoreHitNumber(UUserWidget* HitNumberWidget, FVector Location)
 {
+	if (HitNumberWidget == nullptr) return;
+
 	HitNumbersMap.Add(HitNumberWidget, Location);
+	SetActorTickEnabled(true);
 
 	FTimerHandle HitNumberTimer;
 	FTimerDelegate HitNumberDelegate;
@@ -242,7 +397,12 @@ void AEnemy::StoreHitNumber(UUserWidget* HitNumberWidget, FVector Location)
 void AEnemy::DestroyHitNumber(UUserWidget* HitNumberWidget)
 {
 	HitNumbersMap.Remove(HitNumberWidget);
-	HitNumberWidget->RemoveFromParent();
+
+	if (HitNumberWidget)
+		HitNumberWidget->RemoveFromParent();
+
+	if (HitNumbersMap.IsEmpty())
+		SetActorTickEnabled(false);
 }
 
 void AEnemy::UpdateHitNumbers()
@@ -251,6 +411,7 @@ void AEnemy::UpdateHitNumbers()
 	{
 		UUserWidget* HitNumberWg = HitPairs.Key;
 		const FVector HitNumberLoc = HitPairs.Value;
+		if (HitNumberWg == nullptr) continue;
 
 		FVector2D HitNumberScreenPos;
 		UGameplayStatics::ProjectWorldToScreen(GetWorld()->GetFirstPlayerController(), HitNumberLoc, HitNumberScreenPos);
@@ -268,7 +429,7 @@ void AEnemy::SetStunned(bool IsStunned)
 	
 	if (bStunned) SetAttacking(false);
 
-	EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("Stunned"), bStunned);
+	EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().Stunned, bStunned);
 
 	SetCanMove(true);
 }
@@ -281,7 +442,7 @@ void AEnemy::SetAttacking(bool IsAttacking)
 	if (!bCanMove) SetCanMove(true);
 
 	bAttacking = IsAttacking;
-	EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("Attacking"), bAttacking);
+	EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().Attacking, bAttacking);
 }
 
 void AEnemy::SetCanMove(bool CanMove)
@@ -290,7 +451,7 @@ void AEnemy::SetCanMove(bool CanMove)
 	if (EnemyController == nullptr) return;
 
 	bCanMove = CanMove;
-	EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("CanMove"), bCanMove);
+	EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().CanMove, bCanMove);
 }
 
 void AEnemy::SetInvestigating(bool Investigate)
@@ -298,7 +459,7 @@ void AEnemy::SetInvestigating(bool Investigate)
 	if (HealthComponent->IsDead()) return;
 	if (EnemyController == nullptr) return;
 
-	EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("IsInvestigating"), Investigate);
+	EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().IsInvestigating, Investigate);
 }
 
 void AEnemy::CombatRangeSphereOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -312,7 +473,7 @@ void AEnemy::CombatRangeSphereOverlapBegin(UPrimitiveComponent* OverlappedCompon
 		bInAttackRange = true;
 
 		if (EnemyController)
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("InAttackRange"), bInAttackRange);
+			EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().InAttackRange, bInAttackRange);
 	}
 }
 
@@ -325,7 +486,7 @@ void AEnemy::CombatRangeSphereOverlapEnd(UPrimitiveComponent* OverlappedComponen
 		bInAttackRange = false;
 
 		if (EnemyController)
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("InAttackRange"), bInAttackRange);
+			EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().InAttackRange, bInAttackRange);
 	}
 }
 
@@ -354,12 +515,12 @@ void AEnemy::DetectPlayer(AActor* OtherActor)
 		//Set value of 'Target' Blackboard Key
 		if (!bGreetedPlayer)
 		{
-			EnemyController->GetBlackboardComponent()->SetValueAsObject(TEXT("Target"), OtherActor);
+			EnemyController->SetBlackboardObject(EnemyController->GetBlackboardKeys().Target, OtherActor);
 			bGreetedPlayer = true;
 
-			if (FMath::FRand() <= 0.6f)
+			if (URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::AIStream).FRand() <= 0.6f)
 			{
-				PlayTheSound("GreetSound", true, false, 1.0f);
+				PlayTheSound(ESoundType::EST_GreetSound, true, false, 1.0f);
 
 				UAnimInstance* AnimInst = GetMesh()->GetAnimInstance();
 				if (AnimInst && TauntMontage)
@@ -376,12 +537,77 @@ void AEnemy::InvestigateNoiseLocation(const FVector& NoiseLocation)
 	if (HealthComponent && HealthComponent->IsDead()) return;
 	if (EnemyController == nullptr) return;
 	if (FMath::IsNearlyEqual(NoiseLocation.Size(), 0.01)) return;
-	if (EnemyController->GetBlackboardComponent()->GetValueAsObject("Target")) return;
+	if (EnemyController->GetBlackboardObject(EnemyController->GetBlackboardKeys().Target)) return;
 
 	SetInvestigating(true);
 	SetCanMove(true);
 
-	EnemyController->GetBlackboardComponent()->SetValueAsVector("InvestigateLocation", NoiseLocation);
+	EnemyController->SetBlackboardVector(EnemyController->GetBlackboardKeys().InvestigateLocation, NoiseLocation);
+}
+
+void AEnemy::ApplySignificance(const FEnemySignificanceTier& Tier)
+{
+	GetCharacterMovement()->SetComponentTickInterval(Tier.MovementTickInterval);
+
+	//Mesh tick rate belongs to the animation budget allocator while it is running
+	const IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (Allocator == nullptr || !Allocator->GetEnabled())
+	{
+		GetMesh()->SetComponentTickInterval(Tier.AnimationTickInterval);
+		GetMesh()->VisibilityBasedAnimTickOption = Tier.bOnlyTickPoseWhenRendered ? EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered : MeshAnimTickOption;
+	}
+
+	//UBehaviorTreeComponent overwrites its own tick interval every tick, so the tree is throttled by skipping ticks instead
+	if (EnemyController)
+	{
+		if (UEnemyBehaviorTreeComponent* BehaviorTreeComponent = Cast<UEnemyBehaviorTreeComponent>(EnemyController->GetBrainComponent()))
+			BehaviorTreeComponent->SetThrottleInterval(Tier.BehaviorTickInterval);
+	}
+}
+
+void AEnemy::StartRagdoll()
+{
+	//A throttled ragdoll visibly stutters, so it always ticks while simulating
+	if (IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld()))
+	{
+		if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+			Allocator->SetComponentSignificance(BudgetedMesh, 1.0f, true);
+	}
+
+	GetMesh()->SetAllBodiesSimulatePhysics(true);
+	GetMesh()->SetSimulatePhysics(true);
+	GetMesh()->SetAllBodiesPhysicsBlendWeight(1.0f);
+	GetMesh()->SetCollisionProfileName(TEXT("Ragdoll"));
+	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
+}
+
+void AEnemy::SetAnimationBudgeted(bool bBudgeted)
+{
+	USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+	if (BudgetedMesh == nullptr) return;
+
+	//Also covers the mesh being re-registered, e.g. by a reattach, while it is out of the budget
+	BudgetedMesh->SetAutoRegisterWithBudgetAllocator(bBudgeted);
+
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (Allocator == nullptr) return;
+
+	const bool bRegistered = BudgetedMesh->GetAnimationBudgetHandle() != INDEX_NONE;
+	if (bBudgeted && !bRegistered)
+		Allocator->RegisterComponent(BudgetedMesh);
+	else if (!bBudgeted && bRegistered)
+		Allocator->UnregisterComponent(BudgetedMesh);
+}
+
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (EnemyManager)
+		EnemyManager->UnregisterEnemy(this);
+
+	if (CorpseManager)
+		CorpseManager->UnregisterCorpse(this);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEnemy::Tick(float DeltaTime)
@@ -389,30 +615,37 @@ void AEnemy::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 
 	UpdateHitNumbers();
+
+	if (HitNumbersMap.IsEmpty())
+		SetActorTickEnabled(false);
 }
 
 void AEnemy::PlayTheSound(const FString& SoundName, bool bFadeIn, bool bFadeOut, float VolumeMultiplier)
 {
-	if (AudioComponent == nullptr || SoundsDataAsset == nullptr) return;
-	if (!SoundsDataAsset->AudioMap.Contains(SoundName) || SoundsDataAsset->AudioMap[SoundName] == nullptr) return;
+	if (SoundsDataAsset == nullptr || AudioVoiceSubsystem == nullptr) return;
+
+	//Names outside ESoundType still resolve through the registry and play as Misc voices
+	const EVoiceCategory Category = UAudioVoiceSubsystem::GetCategoryForSound(FIndexedSoundRegistry::GetSoundType(SoundName));
+	AudioVoiceSubsystem->PlayActorSound(this, SoundsDataAsset->SoundRegistry.Find(SoundName), Category, bFadeIn, bFadeOut, VolumeMultiplier);
+}
+
+void AEnemy::PlayTheSound(ESoundType SoundType, bool bFadeIn, bool bFadeOut, float VolumeMultiplier)
+{
+	if (SoundsDataAsset == nullptr || AudioVoiceSubsystem == nullptr) return;
 
-	auto& Sound = SoundsDataAsset->AudioMap[SoundName];
-	AudioComponent->SetSound(Sound);
-	AudioComponent->SetVolumeMultiplier(VolumeMultiplier);
+	AudioVoiceSubsystem->PlayActorSound(this, SoundsDataAsset->SoundRegistry.Get(SoundType), UAudioVoiceSubsystem::GetCategoryForSound(SoundType), bFadeIn, bFadeOut, VolumeMultiplier);
+}
 
-	if (bFadeIn)
-		AudioComponent->FadeIn(0.5f);
-	else if (bFadeOut)
-		AudioComponent->FadeOut(0.5f, 1.0f);
-	else
-		AudioComponent->Play();
+UAudioComponent* AEnemy::GetAudioComponent() const
+{
+	return AudioVoiceSubsystem ? AudioVoiceSubsystem->GetLatestVoiceOf(this) : nullptr;
 }
 
 FVector AEnemy::GetEnemyTargetLocation() const
 {
 	if (!bGreetedPlayer || EnemyController == nullptr) return FVector::ZeroVector;
 
-	if (auto Character = Cast<IShooterActions>(EnemyController->GetBlackboardComponent()->GetValueAsObject(TEXT("Target"))))
+	if (auto Character = Cast<IShooterActions>(EnemyController->GetBlackboardObject(EnemyController->GetBlackboardKeys().Target)))
 		return Character->GetShooterLocation_Implementation();
 
 	return FVector::ZeroVector;
@@ -420,17 +653,34 @@ FVector AEnemy::GetEnemyTargetLocation() const
 
 void AEnemy::ProcessDamage_Implementation(const FHitResult& HitResult, const float& DamageAmount, AActor* Shooter, AController* ShooterController)
 {
-	PlayTheSound("BulletHitSound", false, false, 2.0f);
+	PlayTheSound(ESoundType::EST_BulletHitSound, false, false, 2.0f);
 
 	if (ImpactParticles)
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, HitResult.Location, FRotator(0.0f), true);
+		UFXPoolSubsystem::SpawnEffect(this, ImpactParticles, EFXCategory::EFXC_Impact, HitResult.Location);
 
-	bool bHeadshot = (HitResult.BoneName.ToString() == HeadBone);
+	const bool bHeadshot = GetHitZone(HitResult) == EHitZone::EHZ_Head;
 	ShowHitNumber((int32)DamageAmount, HitResult.Location, bHeadshot);
 
 	UGameplayStatics::ApplyDamage(this, DamageAmount, ShooterController, Shooter, UDamageType::StaticClass());
 }
 
+EHitZone AEnemy::GetHitZone(const FHitResult& HitResult) const
+{
+	//Skeletal mesh hits report the index of the body instance in Item
+	if (HitZoneDataAsset && HitResult.GetComponent() == GetMesh())
+		return HitZoneDataAsset->GetBodyZone(GetMesh()->GetPhysicsAsset(), HitResult.Item);
+
+	return !HeadBoneName.IsNone() && HitResult.BoneName == HeadBoneName ? EHitZone::EHZ_Head : EHitZone::EHZ_Torso;
+}
+
+float AEnemy::ResolveHitDamage(const FHitResult& HitResult, float BodyDamage, float HeadshotDamage) const
+{
+	const EHitZone HitZone = GetHitZone(HitResult);
+	const float Damage = HitZone == EHitZone::EHZ_Head ? HeadshotDamage : BodyDamage;
+
+	return HitZoneDataAsset ? Damage * HitZoneDataAsset->GetDamageMultiplier(HitZone) : Damage;
+}
+
 void AEnemy::JumpToDestination_Implementation(FVector Destination)
 {
 	if (HealthComponent == nullptr || HealthComponent->IsDead()) return;
@@ -442,19 +692,19 @@ void AEnemy::JumpToDestination_Implementation(FVector Destination)
 	FVector LaunchVelocity = FVector::ZeroVector;
 	UGameplayStatics::SuggestProjectileVelocity_CustomArc(this, LaunchVelocity, StartPos, EndPos);
 
-	PlayTheSound("JumpSound", true, false, 1.0f);
+	PlayTheSound(ESoundType::EST_JumpSound, true, false, 1.0f);
 
 	LaunchCharacter(LaunchVelocity, true, true);
 }
 
 void AEnemy::ApplyStun_Implementation()
 {
-	const float StunningChance = FMath::FRandRange(0.0f, 1.0f);
+	const float StunningChance = URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::CombatStream).FRandRange(0.0f, 1.0f);
 	if (StunningChance <= StunChance)
 	{
 		SetStunnedStatus_Implementation(true);
 		PlayHitMontage("HitReactFront");
-		PlayTheSound("StunSound", true, false, 1.0f);
+		PlayTheSound(ESoundType::EST_StunSound, true, false, 1.0f);
 	}
 }
 
@@ -467,7 +717,7 @@ void AEnemy::SetStunnedStatus_Implementation(bool IsStunned)
 
 	if (bStunned) SetAttackingStatus_Implementation(false);
 
-	EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("Stunned"), bStunned);
+	EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().Stunned, bStunned);
 
 	SetCanMoveStatus_Implementation(true);
 }
@@ -480,7 +730,7 @@ void AEnemy::SetAttackingStatus_Implementation(bool IsAttacking)
 	if (!bCanMove) SetCanMoveStatus_Implementation(true);
 
 	bAttacking = IsAttacking;
-	EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("Attacking"), bAttacking);
+	EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().Attacking, bAttacking);
 }
 
 void AEnemy::SetCanMoveStatus_Implementation(bool CanMove)
@@ -489,7 +739,7 @@ void AEnemy::SetCanMoveStatus_Implementation(bool CanMove)
 	if (EnemyController == nullptr) return;
 
 	bCanMove = CanMove;
-	EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("CanMove"), bCanMove);
+	EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().CanMove, bCanMove);
 }
 
 void AEnemy::SetInvestigatingStatus_Implementation(bool Investigate)
@@ -497,7 +747,7 @@ void AEnemy::SetInvestigatingStatus_Implementation(bool Investigate)
 	if (HealthComponent == nullptr || HealthComponent->IsDead()) return;
 	if (EnemyController == nullptr) return;
 
-	EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("IsInvestigating"), Investigate);
+	EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().IsInvestigating, Investigate);
 }
 
 void AEnemy::SetWeaponLeftStatus_Implementation(bool Activate)
@@ -530,7 +780,7 @@ float AEnemy::TakeDamage(float DamageAmount, const FDamageEvent& DamageEvent, AC
 		EnemyManager->OnEnemyHitDelegate.Broadcast(this);
 
 	if (EnemyController)
-		EnemyController->GetBlackboardComponent()->SetValueAsObject(TEXT("Target"), DamageCauser);
+		EnemyController->SetBlackboardObject(EnemyController->GetBlackboardKeys().Target, DamageCauser);
 
 	if (!bGreetedPlayer) bGreetedPlayer = true;
 
@@ -7,6 +7,8 @@
 #include "IPawnActions.h"
 #include "IEnemyPawnActions.h"
 #include "IDamageable.h"
+#include "SoundType.h"
+#include "HitZone.h"
 #include "Enemy.generated.h"
 
 class UParticleSystem;
@@ -14,7 +16,6 @@ class USoundCue;
 class UBehaviorTree;
 class USphereComponent;
 class UBoxComponent;
-class UAudioComponent;
 
 class AEnemyController;
 class AShooterCharacter;
@@ -22,6 +23,12 @@ class UHealthComponent;
 class USoundsDataAsset;
 class AShooterGameState;
 class UEnemyManagerSubsystem;
+class UCorpseManagerSubsystem;
+class UAudioVoiceSubsystem;
+class UAudioComponent;
+class UHitZoneDataAsset;
+class UUserWidget;
+struct FEnemySignificanceTier;
 
 UCLASS()
 class STEPHEN_TP_SHOOTER_API AEnemy : public ACharacter, public IDamageable, public IPawnActions, public IEnemyPawnActions
@@ -29,10 +36,11 @@ class STEPHEN_TP_SHOOTER_API AEnemy : public ACharacter, public IDamageable, pub
 	GENERATED_BODY()
 
 public:
-	AEnemy();
+	AEnemy(const FObjectInitializer& ObjectInitializer);
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual float TakeDamage(float DamageAmount, const FDamageEvent& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 	
@@ -51,8 +59,6 @@ protected:
 	virtual void PlayAttack_Implementation(FName MontageSection, float PlayRate = 1.0f) override;
 	virtual bool IsTargetDead_Implementation() override;
 
-	void UpdateHitNumbers();
-
 	UFUNCTION(BlueprintNativeEvent)
 	void ShowHealthBarEvent();
 
@@ -68,12 +74,15 @@ protected:
 	UFUNCTION(BlueprintCallable)
 	void PlayHitMontage(FName MontageSection, float PlayRate = 1.0f);
 
-	UFUNCTION(BlueprintCallable)
+	//Kept for Blueprints that still create their own hit number widget, it follows its hit location until HitNumberDestroyTime
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Hit numbers are pooled by the player's HitNumberComponent, call the parent ShowHitNumber instead"))
 	void StoreHitNumber(UUserWidget* HitNumberWidget, FVector Location);
 
 	UFUNCTION()
 	void DestroyHitNumber(UUserWidget* HitNumberWidget);
 
+	void UpdateHitNumbers();
+
 	UFUNCTION(BlueprintCallable)
 	void SetStunned(bool IsStunned);
 
@@ -111,22 +120,32 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Events", meta = (AllowPrivateAccess = "true"))
 	UEnemyManagerSubsystem* EnemyManager;
 
+	UPROPERTY()
+	UCorpseManagerSubsystem* CorpseManager;
+
+	UPROPERTY()
+	UAudioVoiceSubsystem* AudioVoiceSubsystem;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat - Particles", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UParticleSystem> ImpactParticles;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UHealthComponent> HealthComponent;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat - Audio", meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UAudioComponent> AudioComponent;
-
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat - Audio", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<USoundsDataAsset> SoundsDataAsset;
 
-	//Name of the Head bone for Headshots
+	//Name of the Head bone for Headshots, also the head zone of a HitZoneDataAsset that does not list it
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	FString HeadBone;
 
+	//HeadBone converted once at BeginPlay
+	FName HeadBoneName;
+
+	//Hit zones and zone damage multipliers shared by every Enemy of this type
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UHitZoneDataAsset> HitZoneDataAsset;
+
 	//Time to display Health Bar once shot
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	float HealthBarDisplayTime;
@@ -140,14 +159,14 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	float HitReactTimeMax;
 
-	//Map to store Hit number widgets and their Hit Locations
-	UPROPERTY(VisibleAnywhere, Category = "Combat", meta = (AllowPrivateAccess = "true"))
-	TMap<UUserWidget*, FVector> HitNumbersMap;
-
 	//Time before a HitNumberBP removed from screen
 	UPROPERTY(EditAnywhere, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	float HitNumberDestroyTime;
 
+	//Map to store Hit number widgets from StoreHitNumber and their Hit Locations
+	UPROPERTY(VisibleAnywhere, Category = "Combat", meta = (AllowPrivateAccess = "true"))
+	TMap<UUserWidget*, FVector> HitNumbersMap;
+
 	//Behavior Tree for the AI Character
 	UPROPERTY(EditAnywhere, Category = "Behavior Tree", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UBehaviorTree> BehaviorTree;
@@ -220,6 +239,16 @@ private:
 	//Custom AIController
 	TObjectPtr<AEnemyController> EnemyController;
 
+	//True when this Enemy is owned by the Enemy Manager pool and gets reused instead of destroyed
+	bool bPooled;
+
+	//Mesh placement and collision captured at BeginPlay, restored after ragdoll when reused
+	FTransform MeshRelativeTransform;
+	FName MeshCollisionProfileName;
+
+	//Anim tick option the mesh was authored with, restored when the Enemy moves back to a near significance tier
+	EVisibilityBasedAnimTickOption MeshAnimTickOption;
+
 	//Section names of Attack Montage Names
 	FName AttackSectionNames[4];
 
@@ -228,23 +257,56 @@ private:
 	FTimerHandle DestroyTimerHandle;
 
 public:
-	UFUNCTION(BlueprintImplementableEvent)
+	//Forwards the hit to the player's UHitNumberComponent, Blueprint overrides call the parent to keep the pooled number
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	void ShowHitNumber(int32 DamageToShow, FVector HitLocation, bool bHeadshot);
 
 	UFUNCTION(BlueprintCallable)
 	void PlayTheSound(const FString& SoundName, bool bFadeIn, bool bFadeOut, float VolumeMultiplier);
 
+	//Indexed lookup used by native code, the FString overload is kept for Blueprints
+	void PlayTheSound(ESoundType SoundType, bool bFadeIn, bool bFadeOut, float VolumeMultiplier);
+
+	//Voice currently playing for this Enemy, replaces the old AudioComponent property in Blueprints
+	UFUNCTION(BlueprintPure, Category = "Combat - Audio")
+	UAudioComponent* GetAudioComponent() const;
+
 	UFUNCTION(BlueprintCallable)
 	void DetectPlayer(AActor* OtherActor);
 
 	UFUNCTION(BlueprintCallable)
 	FVector GetEnemyTargetLocation() const;
 
+	//Wakes a pooled Enemy at SpawnTransform and broadcasts it as a fresh spawn
+	void ActivateFromPool(const FTransform& SpawnTransform);
+
+	//Resets health, ragdoll, AI and flags, then hides the Enemy until it is reused
+	void DeactivateToPool();
+
+	//Scales movement, animation and behavior tree update rates to the given significance tier
+	void ApplySignificance(const FEnemySignificanceTier& Tier);
+
+	//Switches the mesh to full body ragdoll, started by the corpse manager once there is physics budget
+	void StartRagdoll();
+
+	//Hands the mesh tick to the animation budget allocator or takes it back, a frozen or pooled corpse must leave it so its tick stays off
+	void SetAnimationBudgeted(bool bBudgeted);
+
 	UFUNCTION(BlueprintCallable)
 	FORCEINLINE bool IsAttacking() const { return bAttacking; }
 
 	FORCEINLINE bool HasGreetedPlayer() const { return bGreetedPlayer; }
+	FORCEINLINE bool IsStunned() const { return bStunned; }
+	FORCEINLINE bool IsInAttackRange() const { return bInAttackRange; }
+	FORCEINLINE bool IsPooled() const { return bPooled; }
+	FORCEINLINE void SetPooled(bool Pooled) { bPooled = Pooled; }
 	FORCEINLINE FString GetHeadBone() const { return HeadBone; }
+
+	//Zone of the physics body a weapon trace hit
+	EHitZone GetHitZone(const FHitResult& HitResult) const;
+
+	//Damage of one bullet hit, the zone picks body or headshot damage and scales it by the zone multiplier
+	float ResolveHitDamage(const FHitResult& HitResult, float BodyDamage, float HeadshotDamage) const;
 	FORCEINLINE TObjectPtr<UBehaviorTree> GetBehaviorTree() const { return BehaviorTree; }
 	FORCEINLINE TObjectPtr<UHealthComponent> GetHealthComponent() const { return HealthComponent; }
 };
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyBehaviorTreeComponent.h"
+#include "SurvivalBenchmarkSubsystem.h"
+
+UEnemyBehaviorTreeComponent::UEnemyBehaviorTreeComponent() :
+	ThrottleInterval(0.0f),
+	SkippedDeltaTime(0.0f)
+{
+}
+
+void UEnemyBehaviorTreeComponent::SetThrottleInterval(float Interval)
+{
+	ThrottleInterval = FMath::Max(Interval, 0.0f);
+}
+
+void UEnemyBehaviorTreeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	if (ThrottleInterval > 0.0f)
+	{
+		SkippedDeltaTime += DeltaTime;
+		if (SkippedDeltaTime < ThrottleInterval) return;
+
+		//Latent tasks and services see the whole time since the tree last updated
+		DeltaTime = SkippedDeltaTime;
+	}
+
+	SkippedDeltaTime = 0.0f;
+
+	if (!USurvivalBenchmarkSubsystem::IsRecording())
+	{
+		Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+		return;
+	}
+
+	const double TickStartTime = FPlatformTime::Seconds();
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	USurvivalBenchmarkSubsystem::AddAITickTime(FPlatformTime::Seconds() - TickStartTime);
+}
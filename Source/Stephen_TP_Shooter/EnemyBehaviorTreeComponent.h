@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "EnemyBehaviorTreeComponent.generated.h"
+
+/*
+* Behavior Tree Component used by AEnemyController, times its own tick for the survival benchmark.
+* The tree schedules its own tick interval every tick, so significance throttling skips ticks here until the tier interval has built up.
+*/
+UCLASS()
+class STEPHEN_TP_SHOOTER_API UEnemyBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	UEnemyBehaviorTreeComponent();
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	//Minimum seconds between tree updates, 0 to update whenever the tree asks to
+	void SetThrottleInterval(float Interval);
+
+private:
+	float ThrottleInterval;
+
+	//Time skipped since the last tree update, handed to the tree as its delta time
+	float SkippedDeltaTime;
+};
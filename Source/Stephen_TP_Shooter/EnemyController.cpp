@@ -3,8 +3,12 @@
 
 #include "EnemyController.h"
 #include "Enemy.h"
+#include "EnemyBehaviorTreeComponent.h"
 
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "Navigation/CrowdFollowingComponent.h"
@@ -14,8 +18,10 @@ AEnemyController::AEnemyController()
 	Blackboard = CreateDefaultSubobject<UBlackboardComponent>(TEXT("BlackBoardComp"));
 	check(Blackboard);
 
-	BehaviorTreeComponent = CreateDefaultSubobject<UBehaviorTreeComponent>(TEXT("BehaviorTreeComp"));
+	//Also used as the Brain Component, so RunBehaviorTree runs on it instead of creating another one
+	BehaviorTreeComponent = CreateDefaultSubobject<UEnemyBehaviorTreeComponent>(TEXT("BehaviorTreeComp"));
 	check(BehaviorTreeComponent);
+	BrainComponent = BehaviorTreeComponent;
 }
 
 AEnemyController::AEnemyController(const FObjectInitializer& ObjectInitializer)
@@ -24,8 +30,10 @@ AEnemyController::AEnemyController(const FObjectInitializer& ObjectInitializer)
 	Blackboard = CreateDefaultSubobject<UBlackboardComponent>(TEXT("BlackBoardComp"));
 	check(Blackboard);
 
-	BehaviorTreeComponent = CreateDefaultSubobject<UBehaviorTreeComponent>(TEXT("BehaviorTreeComp"));
+	//Also used as the Brain Component, so RunBehaviorTree runs on it instead of creating another one
+	BehaviorTreeComponent = CreateDefaultSubobject<UEnemyBehaviorTreeComponent>(TEXT("BehaviorTreeComp"));
 	check(BehaviorTreeComponent);
+	BrainComponent = BehaviorTreeComponent;
 }
 
 void AEnemyController::OnPossess(APawn* InPawn)
@@ -37,4 +45,64 @@ void AEnemyController::OnPossess(APawn* InPawn)
 	Enemy = Cast<AEnemy>(InPawn);
 	if (Enemy && Enemy->GetBehaviorTree())
 		Blackboard->InitializeBlackboard(*(Enemy->GetBehaviorTree()->BlackboardAsset));
+
+	CacheBlackboardKeys();
+}
+
+void AEnemyController::CacheBlackboardKeys()
+{
+	BlackboardKeys = FEnemyBlackboardKeys();
+	if (Blackboard == nullptr || Blackboard->GetBlackboardAsset() == nullptr) return;
+
+	BlackboardKeys.Target = Blackboard->GetKeyID(TEXT("Target"));
+	BlackboardKeys.TargetDead = Blackboard->GetKeyID(TEXT("TargetDead"));
+	BlackboardKeys.Dead = Blackboard->GetKeyID(TEXT("Dead"));
+	BlackboardKeys.Stunned = Blackboard->GetKeyID(TEXT("Stunned"));
+	BlackboardKeys.Attacking = Blackboard->GetKeyID(TEXT("Attacking"));
+	BlackboardKeys.CanMove = Blackboard->GetKeyID(TEXT("CanMove"));
+	BlackboardKeys.IsInvestigating = Blackboard->GetKeyID(TEXT("IsInvestigating"));
+	BlackboardKeys.InAttackRange = Blackboard->GetKeyID(TEXT("InAttackRange"));
+	BlackboardKeys.PatrolPoint = Blackboard->GetKeyID(TEXT("PatrolPoint"));
+	BlackboardKeys.PatrolPoint2 = Blackboard->GetKeyID(TEXT("PatrolPoint2"));
+	BlackboardKeys.InvestigateLocation = Blackboard->GetKeyID(TEXT("InvestigateLocation"));
+}
+
+void AEnemyController::ResetBlackboard()
+{
+	if (Blackboard == nullptr || Blackboard->GetBlackboardAsset() == nullptr) return;
+
+	const int32 NumKeys = Blackboard->GetNumKeys();
+	for (int32 KeyIndex = 0; KeyIndex < NumKeys; KeyIndex++)
+		Blackboard->ClearValue(FBlackboard::FKey(KeyIndex));
+}
+
+void AEnemyController::SetBlackboardBool(FBlackboard::FKey KeyID, bool bValue)
+{
+	if (Blackboard == nullptr || KeyID == FBlackboard::InvalidKey) return;
+	if (Blackboard->GetValue<UBlackboardKeyType_Bool>(KeyID) == bValue) return;
+
+	Blackboard->SetValue<UBlackboardKeyType_Bool>(KeyID, bValue);
+}
+
+void AEnemyController::SetBlackboardVector(FBlackboard::FKey KeyID, const FVector& Value)
+{
+	if (Blackboard == nullptr || KeyID == FBlackboard::InvalidKey) return;
+	if (Blackboard->GetValue<UBlackboardKeyType_Vector>(KeyID).Equals(Value)) return;
+
+	Blackboard->SetValue<UBlackboardKeyType_Vector>(KeyID, Value);
+}
+
+void AEnemyController::SetBlackboardObject(FBlackboard::FKey KeyID, UObject* Value)
+{
+	if (Blackboard == nullptr || KeyID == FBlackboard::InvalidKey) return;
+	if (Blackboard->GetValue<UBlackboardKeyType_Object>(KeyID) == Value) return;
+
+	Blackboard->SetValue<UBlackboardKeyType_Object>(KeyID, Value);
+}
+
+UObject* AEnemyController::GetBlackboardObject(FBlackboard::FKey KeyID) const
+{
+	if (Blackboard == nullptr || KeyID == FBlackboard::InvalidKey) return nullptr;
+
+	return Blackboard->GetValue<UBlackboardKeyType_Object>(KeyID);
 }
\ No newline at end of file
@@ -4,11 +4,43 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include "EnemyController.generated.h"
 
 class AEnemy;
 class UBehaviorTreeComponent;
 
+//Blackboard key IDs of the Enemy Behavior Tree, resolved once on possess so writes skip the name lookup
+struct FEnemyBlackboardKeys
+{
+	FBlackboard::FKey Target;
+	FBlackboard::FKey TargetDead;
+	FBlackboard::FKey Dead;
+	FBlackboard::FKey Stunned;
+	FBlackboard::FKey Attacking;
+	FBlackboard::FKey CanMove;
+	FBlackboard::FKey IsInvestigating;
+	FBlackboard::FKey InAttackRange;
+	FBlackboard::FKey PatrolPoint;
+	FBlackboard::FKey PatrolPoint2;
+	FBlackboard::FKey InvestigateLocation;
+
+	FEnemyBlackboardKeys()
+	{
+		Target = FBlackboard::InvalidKey;
+		TargetDead = FBlackboard::InvalidKey;
+		Dead = FBlackboard::InvalidKey;
+		Stunned = FBlackboard::InvalidKey;
+		Attacking = FBlackboard::InvalidKey;
+		CanMove = FBlackboard::InvalidKey;
+		IsInvestigating = FBlackboard::InvalidKey;
+		InAttackRange = FBlackboard::InvalidKey;
+		PatrolPoint = FBlackboard::InvalidKey;
+		PatrolPoint2 = FBlackboard::InvalidKey;
+		InvestigateLocation = FBlackboard::InvalidKey;
+	}
+};
+
 UCLASS()
 class STEPHEN_TP_SHOOTER_API AEnemyController : public AAIController
 {
@@ -18,6 +50,16 @@ public:
 	AEnemyController();
 	AEnemyController(const FObjectInitializer& ObjectInitializer);
 
+	//Clears every Blackboard key back to its default value
+	void ResetBlackboard();
+
+	//Blackboard writes through cached key IDs, skipped when the stored value is already the same so observers are not re-triggered
+	void SetBlackboardBool(FBlackboard::FKey KeyID, bool bValue);
+	void SetBlackboardVector(FBlackboard::FKey KeyID, const FVector& Value);
+	void SetBlackboardObject(FBlackboard::FKey KeyID, UObject* Value);
+
+	UObject* GetBlackboardObject(FBlackboard::FKey KeyID) const;
+
 protected:
 	virtual void OnPossess(APawn* InPawn) override;
 
@@ -28,4 +70,11 @@ private:
 
 	UPROPERTY(BlueprintReadWrite, Category = "AI Behavior", meta = (AllowPrivateAccess = "true"))
 	AEnemy* Enemy;
+
+	FEnemyBlackboardKeys BlackboardKeys;
+
+	void CacheBlackboardKeys();
+
+public:
+	FORCEINLINE const FEnemyBlackboardKeys& GetBlackboardKeys() const { return BlackboardKeys; }
 };
\ No newline at end of file
@@ -2,8 +2,397 @@
 
 
 #include "EnemyManagerSubsystem.h"
+#include "Enemy.h"
+#include "HealthComponent.h"
+#include "Stephen_TP_Shooter.h"
+
+#include "AnimationBudgetAllocatorParameters.h"
+#include "Camera/PlayerCameraManager.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Meshes Throttled"), STAT_EnemyMeshesThrottled, STATGROUP_GunBound);
+
+UEnemyManagerSubsystem::UEnemyManagerSubsystem() :
+	SignificanceHysteresis(200.0f),
+	BehindCameraTierPenalty(1),
+	bUseAnimationBudget(true),
+	AnimationBudgetBaseMs(0.5f),
+	AnimationBudgetPerEnemyMs(0.05f),
+	AnimationSignificanceDistance(8000.0f),
+	OffscreenSignificanceScale(0.25f),
+	ThrottledMeshCount(0)
+{
+}
 
 void UEnemyManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+}
+
+void UEnemyManagerSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(&InWorld))
+		Allocator->SetEnabled(bUseAnimationBudget);
+}
+
+void UEnemyManagerSubsystem::Deinitialize()
+{
+	EnemyPools.Empty();
+
+	EnemyPositions.Empty();
+	EnemyHealths.Empty();
+	EnemyStateFlags.Empty();
+	EnemySignificanceTiers.Empty();
+	EnemyHandles.Empty();
+	EnemyKeys.Empty();
+	EnemyIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+void UEnemyManagerSubsystem::PrewarmPool(TSubclassOf<AEnemy> EnemyClass, int32 Count, int32 Capacity)
+{
+	if (EnemyClass == nullptr) return;
+
+	FEnemyPool& Pool = EnemyPools.FindOrAdd(EnemyClass);
+	Pool.Capacity = FMath::Max(Pool.Capacity, Capacity);
+
+	const int32 ToSpawn = FMath::Min(Count, Pool.Capacity) - Pool.InactiveEnemies.Num();
+	for (int32 i = 0; i < ToSpawn; i++)
+	{
+		if (AEnemy* Enemy = SpawnPooledEnemy(EnemyClass))
+		{
+			Enemy->DeactivateToPool();
+			Pool.InactiveEnemies.Add(Enemy);
+		}
+	}
+}
+
+AEnemy* UEnemyManagerSubsystem::AcquireEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& SpawnTransform)
+{
+	if (EnemyClass == nullptr) return nullptr;
+
+	AEnemy* Enemy = nullptr;
+
+	FEnemyPool& Pool = EnemyPools.FindOrAdd(EnemyClass);
+	while (Enemy == nullptr && Pool.InactiveEnemies.Num() > 0)
+		Enemy = Pool.InactiveEnemies.Pop(false);
+
+	if (Enemy == nullptr)
+		Enemy = SpawnPooledEnemy(EnemyClass);
+
+	if (Enemy)
+		Enemy->ActivateFromPool(SpawnTransform);
+
+	return Enemy;
+}
+
+void UEnemyManagerSubsystem::ReleaseEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	FEnemyPool* Pool = EnemyPools.Find(Enemy->GetClass());
+	if (Pool == nullptr || !Enemy->IsPooled() || Pool->InactiveEnemies.Num() >= Pool->Capacity)
+	{
+		Enemy->Destroy();
+		return;
+	}
+
+	Enemy->DeactivateToPool();
+	Pool->InactiveEnemies.AddUnique(Enemy);
+}
+
+int32 UEnemyManagerSubsystem::GetPooledCount(TSubclassOf<AEnemy> EnemyClass) const
+{
+	const FEnemyPool* Pool = EnemyPools.Find(EnemyClass);
+	return Pool ? Pool->InactiveEnemies.Num() : 0;
+}
+
+AEnemy* UEnemyManagerSubsystem::SpawnPooledEnemy(TSubclassOf<AEnemy> EnemyClass)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr) return nullptr;
+
+	//Deferred so the enemy knows it is pooled before BeginPlay runs
+	AEnemy* Enemy = World->SpawnActorDeferred<AEnemy>(EnemyClass, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (Enemy == nullptr) return nullptr;
+
+	Enemy->SetPooled(true);
+	Enemy->FinishSpawning(FTransform::Identity);
+
+	return Enemy;
+}
+
+TStatId UEnemyManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyManagerSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyManagerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	for (int32 i = EnemyHandles.Num() - 1; i >= 0; i--)
+	{
+		const AEnemy* Enemy = EnemyHandles[i].Get();
+		if (Enemy == nullptr)
+		{
+			RemoveEnemyAt(i);
+			continue;
+		}
+
+		RefreshEnemyAt(i, *Enemy);
+	}
+
+	UpdateSignificance();
+	UpdateAnimationBudget();
+}
+
+void UEnemyManagerSubsystem::NotifyEnemySpawned(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	RegisterEnemy(Enemy);
+
+	if (OnEnemySpawnDelegate.IsBound())
+		OnEnemySpawnDelegate.Broadcast(Enemy);
+}
+
+void UEnemyManagerSubsystem::NotifyEnemyDeath(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	UnregisterEnemy(Enemy);
+
+	if (OnEnemyDeathDelegate.IsBound())
+		OnEnemyDeathDelegate.Broadcast(Enemy);
+}
+
+void UEnemyManagerSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if (EnemyIndices.Contains(Enemy)) return;
+
+	const int32 Index = EnemyHandles.Add(Enemy);
+	EnemyPositions.AddUninitialized();
+	EnemyHealths.AddUninitialized();
+	EnemyStateFlags.AddUninitialized();
+	EnemySignificanceTiers.Add(INDEX_NONE);
+	EnemyKeys.Add(Enemy);
+	EnemyIndices.Add(Enemy, Index);
+
+	RefreshEnemyAt(Index, *Enemy);
+}
+
+void UEnemyManagerSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	const int32* Index = EnemyIndices.Find(Enemy);
+	if (Index == nullptr) return;
+
+	RemoveEnemyAt(*Index);
+}
+
+void UEnemyManagerSubsystem::RemoveEnemyAt(int32 Index)
+{
+	//Dying and pooled Enemies go back to full rate so death animations and reuse are not throttled
+	AEnemy* Enemy = EnemyHandles[Index].Get();
+	if (Enemy && EnemySignificanceTiers[Index] > 0 && SignificanceTiers.Num() > 0)
+		Enemy->ApplySignificance(SignificanceTiers[0]);
+
+	EnemyIndices.Remove(EnemyKeys[Index]);
+
+	EnemyPositions.RemoveAtSwap(Index, 1, false);
+	EnemyHealths.RemoveAtSwap(Index, 1, false);
+	EnemyStateFlags.RemoveAtSwap(Index, 1, false);
+	EnemySignificanceTiers.RemoveAtSwap(Index, 1, false);
+	EnemyHandles.RemoveAtSwap(Index, 1, false);
+	EnemyKeys.RemoveAtSwap(Index, 1, false);
+
+	//Fix up the index of the enemy that was swapped into this slot
+	if (EnemyKeys.IsValidIndex(Index))
+		EnemyIndices.Add(EnemyKeys[Index], Index);
+}
+
+void UEnemyManagerSubsystem::RefreshEnemyAt(int32 Index, const AEnemy& Enemy)
+{
+	EnemyPositions[Index] = Enemy.GetActorLocation();
+	EnemyHealths[Index] = Enemy.GetHealthComponent() ? Enemy.GetHealthComponent()->GetHealth() : 0.0f;
+
+	EEnemyStateFlags Flags = EEnemyStateFlags::EESF_None;
+	if (Enemy.HasGreetedPlayer())	Flags |= EEnemyStateFlags::EESF_Greeted;
+	if (Enemy.IsAttacking())		Flags |= EEnemyStateFlags::EESF_Attacking;
+	if (Enemy.IsStunned())			Flags |= EEnemyStateFlags::EESF_Stunned;
+	if (Enemy.IsInAttackRange())	Flags |= EEnemyStateFlags::EESF_InAttackRange;
+	EnemyStateFlags[Index] = Flags;
+}
+
+void UEnemyManagerSubsystem::UpdateSignificance()
+{
+	if (SignificanceTiers.Num() == 0) return;
+
+	APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0);
+	if (CameraManager == nullptr) return;
+
+	const FVector CameraLocation = CameraManager->GetCameraLocation();
+	const FVector CameraForward = CameraManager->GetCameraRotation().Vector();
+
+	for (int32 i = 0; i < EnemyPositions.Num(); i++)
+	{
+		const FVector ToEnemy = EnemyPositions[i] - CameraLocation;
+		const bool bBehindCamera = FVector::DotProduct(ToEnemy, CameraForward) < 0.0f;
+
+		const int32 NewTier = CalculateSignificanceTier(ToEnemy.SizeSquared(), bBehindCamera, EnemySignificanceTiers[i]);
+		if (NewTier == EnemySignificanceTiers[i]) continue;
+
+		EnemySignificanceTiers[i] = NewTier;
+
+		if (AEnemy* Enemy = EnemyHandles[i].Get())
+			Enemy->ApplySignificance(SignificanceTiers[NewTier]);
+	}
+}
+
+int32 UEnemyManagerSubsystem::CalculateSignificanceTier(float DistanceSq, bool bBehindCamera, int32 CurrentTier) const
+{
+	const int32 LastTier = SignificanceTiers.Num() - 1;
+
+	int32 Tier = 0;
+	while (Tier < LastTier)
+	{
+		//Tiers nearer than the current one need the hysteresis margin before the enemy is promoted into them
+		const float Margin = (CurrentTier != INDEX_NONE && Tier < CurrentTier) ? SignificanceHysteresis : 0.0f;
+		const float MaxDistance = FMath::Max(SignificanceTiers[Tier].MaxDistance - Margin, 0.0f);
+		if (DistanceSq <= MaxDistance * MaxDistance) break;
+
+		Tier++;
+	}
+
+	if (bBehindCamera)
+		Tier += BehindCameraTierPenalty;
+
+	return FMath::Clamp(Tier, 0, LastTier);
+}
+
+void UEnemyManagerSubsystem::ConfigureAnimationBudget(int32 MaxMonsters)
+{
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (Allocator == nullptr || !bUseAnimationBudget) return;
+
+	MaxMonsters = FMath::Max(MaxMonsters, 1);
+
+	FAnimationBudgetAllocatorParameters Parameters;
+	Parameters.BudgetInMs = AnimationBudgetBaseMs + AnimationBudgetPerEnemyMs * MaxMonsters;
+	Parameters.MaxInterpolatedComponents = MaxMonsters;
+	Parameters.MaxTickedOffsreenComponents = FMath::Max(MaxMonsters / 4, 1);
+	Allocator->SetParameters(Parameters);
+
+	UE_LOG(LogGunBound, Log, TEXT("Animation budget set to %.2fms for %d enemies"), Parameters.BudgetInMs, MaxMonsters);
+}
+
+void UEnemyManagerSubsystem::UpdateAnimationBudget()
+{
+	ThrottledMeshCount = 0;
+
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (Allocator == nullptr || !Allocator->GetEnabled()) return;
+
+	APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0);
+	if (CameraManager == nullptr) return;
+
+	const FVector CameraLocation = CameraManager->GetCameraLocation();
+
+	for (int32 i = 0; i < EnemyHandles.Num(); i++)
+	{
+		AEnemy* Enemy = EnemyHandles[i].Get();
+		if (Enemy == nullptr) continue;
+
+		USkeletalMeshComponentBudgeted* Mesh = Cast<USkeletalMeshComponentBudgeted>(Enemy->GetMesh());
+		if (Mesh == nullptr) continue;
+
+		//Mesh ticks run before subsystems, so this reports the frame that just ran
+		if (!Mesh->PoseTickedThisFrame())
+			ThrottledMeshCount++;
+
+		float Significance = 1.0f - FMath::Clamp(FVector::Dist(CameraLocation, EnemyPositions[i]) / AnimationSignificanceDistance, 0.0f, 1.0f);
+		if (!Mesh->WasRecentlyRendered(0.1f))
+			Significance *= OffscreenSignificanceScale;
+
+		Allocator->SetComponentSignificance(Mesh, Significance);
+	}
+
+	SET_DWORD_STAT(STAT_EnemyMeshesThrottled, ThrottledMeshCount);
+}
+
+int32 UEnemyManagerSubsystem::QueryEnemiesInRadius(const FVector& Origin, float Radius, TArray<AEnemy*>& OutEnemies) const
+{
+	const int32 StartNum = OutEnemies.Num();
+	const float RadiusSq = Radius * Radius;
+
+	for (int32 i = 0; i < EnemyPositions.Num(); i++)
+	{
+		if (FVector::DistSquared(Origin, EnemyPositions[i]) > RadiusSq) continue;
+
+		if (AEnemy* Enemy = EnemyHandles[i].Get())
+			OutEnemies.Add(Enemy);
+	}
+
+	return OutEnemies.Num() - StartNum;
+}
+
+int32 UEnemyManagerSubsystem::QueryNearestEnemies(const FVector& Origin, int32 Count, TArray<AEnemy*>& OutEnemies, float MaxRadius) const
+{
+	if (Count <= 0) return 0;
+
+	//Small sorted list of (DistSq, Index), Count is expected to be small
+	TArray<TPair<float, int32>, TInlineAllocator<16>> Nearest;
+	const float MaxRadiusSq = MaxRadius * MaxRadius;
+
+	for (int32 i = 0; i < EnemyPositions.Num(); i++)
+	{
+		const float DistSq = FVector::DistSquared(Origin, EnemyPositions[i]);
+		if (DistSq > MaxRadiusSq) continue;
+		if (Nearest.Num() == Count && DistSq >= Nearest.Last().Key) continue;
+
+		int32 InsertAt = Nearest.Num();
+		while (InsertAt > 0 && Nearest[InsertAt - 1].Key > DistSq)
+			InsertAt--;
+
+		Nearest.Insert(TPair<float, int32>(DistSq, i), InsertAt);
+		if (Nearest.Num() > Count)
+			Nearest.Pop(false);
+	}
+
+	const int32 StartNum = OutEnemies.Num();
+	for (const TPair<float, int32>& Entry : Nearest)
+	{
+		if (AEnemy* Enemy = EnemyHandles[Entry.Value].Get())
+			OutEnemies.Add(Enemy);
+	}
+
+	return OutEnemies.Num() - StartNum;
+}
+
+int32 UEnemyManagerSubsystem::QueryEnemiesInCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float MaxDistance, TArray<AEnemy*>& OutEnemies) const
+{
+	const int32 StartNum = OutEnemies.Num();
+	const FVector ConeDir = Direction.GetSafeNormal();
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+	const float MaxDistanceSq = MaxDistance * MaxDistance;
+
+	for (int32 i = 0; i < EnemyPositions.Num(); i++)
+	{
+		const FVector ToEnemy = EnemyPositions[i] - Origin;
+		const float DistSq = ToEnemy.SizeSquared();
+		if (DistSq > MaxDistanceSq || DistSq < UE_KINDA_SMALL_NUMBER) continue;
+
+		//Compare against cos * length to skip the square root
+		if (FVector::DotProduct(ToEnemy, ConeDir) < CosHalfAngle * FMath::Sqrt(DistSq)) continue;
+
+		if (AEnemy* Enemy = EnemyHandles[i].Get())
+			OutEnemies.Add(Enemy);
+	}
+
+	return OutEnemies.Num() - StartNum;
 }
\ No newline at end of file
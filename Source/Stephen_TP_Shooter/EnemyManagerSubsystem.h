@@ -4,21 +4,98 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 #include "EnemyManagerSubsystem.generated.h"
 
 class AEnemy;
+class APlayerCameraManager;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemySpawnEvent, AEnemy*, Enemy);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyDeathEvent, AEnemy*, Enemy);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyDamageEvent, AEnemy*, Enemy);
 
-UCLASS()
-class STEPHEN_TP_SHOOTER_API UEnemyManagerSubsystem : public UWorldSubsystem
+//Packed per enemy state bits of the registry
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EEnemyStateFlags : uint8
+{
+	EESF_None			= 0			UMETA(Hidden),
+	EESF_Greeted		= 1 << 0	UMETA(DisplayName = "Greeted"),
+	EESF_Attacking		= 1 << 1	UMETA(DisplayName = "Attacking"),
+	EESF_Stunned		= 1 << 2	UMETA(DisplayName = "Stunned"),
+	EESF_InAttackRange	= 1 << 3	UMETA(DisplayName = "In Attack Range")
+};
+ENUM_CLASS_FLAGS(EEnemyStateFlags);
+
+//Update rates applied to an enemy while its distance from the player camera falls in this tier, 0 interval means every frame
+USTRUCT()
+struct FEnemySignificanceTier
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config)
+	float MaxDistance;
+
+	UPROPERTY(Config)
+	float MovementTickInterval;
+
+	UPROPERTY(Config)
+	float AnimationTickInterval;
+
+	//Behavior tree component tick, services and decorators are evaluated at this rate
+	UPROPERTY(Config)
+	float BehaviorTickInterval;
+
+	//Skip pose ticks entirely while the mesh is not rendered
+	UPROPERTY(Config)
+	bool bOnlyTickPoseWhenRendered;
+
+	FEnemySignificanceTier()
+	{
+		MaxDistance = 0.0f;
+		MovementTickInterval = 0.0f;
+		AnimationTickInterval = 0.0f;
+		BehaviorTickInterval = 0.0f;
+		bOnlyTickPoseWhenRendered = false;
+	}
+};
+
+//Inactive enemies of one class, waiting to be reused
+USTRUCT()
+struct FEnemyPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AEnemy>> InactiveEnemies;
+
+	//Max number of inactive enemies kept around, extra ones are destroyed on release
+	int32 Capacity;
+
+	FEnemyPool()
+	{
+		Capacity = 0;
+	}
+};
+
+/*
+* Owns the enemy pools and a structure of arrays registry of every live enemy.
+* Positions, health and state flags are refreshed once per frame so spatial queries run over packed arrays.
+* Each live enemy is also given a significance tier from its distance to the player camera, which scales its update rates.
+*/
+UCLASS(Config = Game)
+class STEPHEN_TP_SHOOTER_API UEnemyManagerSubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
 public:
+	UEnemyManagerSubsystem();
+
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
 
 	UPROPERTY(BlueprintAssignable, Category = "Delegates", meta = (AllowPrivateAccess = "true"))
 	FOnEnemySpawnEvent OnEnemySpawnDelegate;
@@ -28,4 +105,104 @@ public:
 
 	UPROPERTY(BlueprintAssignable, Category = "Delegates", meta = (AllowPrivateAccess = "true"))
 	FOnEnemyDamageEvent OnEnemyHitDelegate;
-};
\ No newline at end of file
+
+	//Makes sure at least Count inactive enemies of EnemyClass are ready, Capacity caps how many are kept
+	void PrewarmPool(TSubclassOf<AEnemy> EnemyClass, int32 Count, int32 Capacity);
+
+	//Takes an enemy from the pool (spawning one if empty) and activates it at SpawnTransform
+	AEnemy* AcquireEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& SpawnTransform);
+
+	//Deactivates the enemy and returns it to its class pool
+	void ReleaseEnemy(AEnemy* Enemy);
+
+	int32 GetPooledCount(TSubclassOf<AEnemy> EnemyClass) const;
+
+	//Registers the enemy as live and broadcasts OnEnemySpawnDelegate
+	void NotifyEnemySpawned(AEnemy* Enemy);
+
+	//Removes the enemy from the live registry and broadcasts OnEnemyDeathDelegate
+	void NotifyEnemyDeath(AEnemy* Enemy);
+
+	//Removes the enemy from the live registry without broadcasting (destroyed or pooled)
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	//Live enemies within Radius of Origin, returns the number found
+	int32 QueryEnemiesInRadius(const FVector& Origin, float Radius, TArray<AEnemy*>& OutEnemies) const;
+
+	//Up to Count live enemies closest to Origin within MaxRadius, sorted nearest first
+	int32 QueryNearestEnemies(const FVector& Origin, int32 Count, TArray<AEnemy*>& OutEnemies, float MaxRadius = UE_BIG_NUMBER) const;
+
+	//Live enemies within MaxDistance inside a cone of HalfAngleDegrees around Direction
+	int32 QueryEnemiesInCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float MaxDistance, TArray<AEnemy*>& OutEnemies) const;
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetLiveEnemyCount() const { return EnemyHandles.Num(); }
+
+	FORCEINLINE const TArray<FVector>& GetEnemyPositions() const { return EnemyPositions; }
+	FORCEINLINE const TArray<float>& GetEnemyHealths() const { return EnemyHealths; }
+	FORCEINLINE const TArray<EEnemyStateFlags>& GetEnemyStateFlags() const { return EnemyStateFlags; }
+	FORCEINLINE const TArray<int32>& GetEnemySignificanceTiers() const { return EnemySignificanceTiers; }
+
+	//Sizes the animation budget for a wave of at most MaxMonsters live enemies
+	void ConfigureAnimationBudget(int32 MaxMonsters);
+
+	//Enemy meshes whose pose was skipped or interpolated this frame
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetThrottledMeshCount() const { return ThrottledMeshCount; }
+
+private:
+	void RegisterEnemy(AEnemy* Enemy);
+	void RemoveEnemyAt(int32 Index);
+	void RefreshEnemyAt(int32 Index, const AEnemy& Enemy);
+
+	void UpdateSignificance();
+	void UpdateAnimationBudget();
+	int32 CalculateSignificanceTier(float DistanceSq, bool bBehindCamera, int32 CurrentTier) const;
+
+	AEnemy* SpawnPooledEnemy(TSubclassOf<AEnemy> EnemyClass);
+
+	UPROPERTY()
+	TMap<TSubclassOf<AEnemy>, FEnemyPool> EnemyPools;
+
+	//Ordered nearest to farthest, enemies beyond the last MaxDistance use the last tier
+	UPROPERTY(Config)
+	TArray<FEnemySignificanceTier> SignificanceTiers;
+
+	//Extra distance an enemy must move back toward the camera before it is promoted, stops tier flicker at the boundaries
+	UPROPERTY(Config)
+	float SignificanceHysteresis;
+
+	//Enemies behind the camera drop this many extra tiers
+	UPROPERTY(Config)
+	int32 BehindCameraTierPenalty;
+
+	//Hands enemy mesh ticking to the animation budget allocator instead of the tier anim tick intervals
+	UPROPERTY(Config)
+	bool bUseAnimationBudget;
+
+	//Game thread animation time budget per frame is AnimationBudgetBaseMs + AnimationBudgetPerEnemyMs * MaxMonsters
+	UPROPERTY(Config)
+	float AnimationBudgetBaseMs;
+
+	UPROPERTY(Config)
+	float AnimationBudgetPerEnemyMs;
+
+	//Distance at which animation significance reaches zero
+	UPROPERTY(Config)
+	float AnimationSignificanceDistance;
+
+	//Significance multiplier for meshes that were not rendered recently
+	UPROPERTY(Config)
+	float OffscreenSignificanceScale;
+
+	int32 ThrottledMeshCount;
+
+	//Live enemy registry, all arrays share the same index and are swap-removed together
+	TArray<FVector> EnemyPositions;
+	TArray<float> EnemyHealths;
+	TArray<EEnemyStateFlags> EnemyStateFlags;
+	TArray<int32> EnemySignificanceTiers;
+	TArray<TWeakObjectPtr<AEnemy>> EnemyHandles;
+	TArray<TObjectKey<AEnemy>> EnemyKeys;
+	TMap<TObjectKey<AEnemy>, int32> EnemyIndices;
+};
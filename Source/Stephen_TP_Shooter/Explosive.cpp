@@ -2,6 +2,8 @@
 
 
 #include "Explosive.h"
+#include "AudioVoiceSubsystem.h"
+#include "FXPoolSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
 #include "Particles/ParticleSystemComponent.h"
@@ -34,15 +36,18 @@ AExplosive::AExplosive() :
 void AExplosive::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (UFXPoolSubsystem* FXPool = UFXPoolSubsystem::Get(this))
+		FXPool->PrewarmEffect(ExplodeParticles, EFXCategory::EFXC_Explosion);
 }
 
 void AExplosive::Explode(AActor* Shooter, AController* ShooterController)
 {
 	if (ExplodeSound)
-		UGameplayStatics::PlaySoundAtLocation(this, ExplodeSound, GetActorLocation());
+		UAudioVoiceSubsystem::SpawnVoiceAtLocation(this, ExplodeSound, EVoiceCategory::EVC_Explosion, GetActorLocation());
 
 	if (ExplodeParticles)
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplodeParticles, GetActorLocation(), FRotator(0.0f), true);
+		UFXPoolSubsystem::SpawnEffect(this, ExplodeParticles, EFXCategory::EFXC_Explosion, GetActorLocation());
 
 	TArray<AActor*> IgnoredActors;
 	IgnoredActors.Add(this);
@@ -0,0 +1,244 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FXPoolSubsystem.h"
+#include "Stephen_TP_Shooter.h"
+
+#include "GameFramework/WorldSettings.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("FX Pool Tick"), STAT_FXPoolTick, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Active"), STAT_FXActive, STATGROUP_GunBound);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Components Created"), STAT_FXComponentsCreated, STATGROUP_GunBound);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Merged"), STAT_FXMerged, STATGROUP_GunBound);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Dropped"), STAT_FXDropped, STATGROUP_GunBound);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Recycled"), STAT_FXRecycled, STATGROUP_GunBound);
+
+UFXPoolSubsystem::UFXPoolSubsystem() :
+	MaxActiveEffects(96),
+	ActiveEffectCount(0)
+{
+}
+
+void UFXPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (uint8 i = 0; i < (uint8)EFXCategory::EFXC_MAX; i++)
+	{
+		ResolvedSettings[i] = FFXCategorySettings();
+		ResolvedSettings[i].Category = (EFXCategory)i;
+	}
+
+	for (const FFXCategorySettings& Settings : CategorySettings)
+	{
+		if (Settings.Category >= EFXCategory::EFXC_MAX) continue;
+
+		ResolvedSettings[(uint8)Settings.Category] = Settings;
+	}
+}
+
+void UFXPoolSubsystem::Deinitialize()
+{
+	Pools.Empty();
+	ActiveEffectCount = 0;
+
+	Super::Deinitialize();
+}
+
+TStatId UFXPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFXPoolSubsystem, STATGROUP_Tickables);
+}
+
+UFXPoolSubsystem* UFXPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (WorldContextObject == nullptr) return nullptr;
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UFXPoolSubsystem>() : nullptr;
+}
+
+UParticleSystemComponent* UFXPoolSubsystem::SpawnEffect(const UObject* WorldContextObject, UParticleSystem* Template, EFXCategory Category, const FVector& Location, const FRotator& Rotation)
+{
+	UFXPoolSubsystem* FXPool = Get(WorldContextObject);
+	return FXPool ? FXPool->SpawnEffectAtLocation(Template, Category, Location, Rotation) : nullptr;
+}
+
+void UFXPoolSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_FXPoolTick);
+
+	//Completed systems deactivate themselves, hand them back to their pool
+	for (TPair<TObjectPtr<UParticleSystem>, FFXPool>& PoolPair : Pools)
+	{
+		FFXPool& Pool = PoolPair.Value;
+		for (int32 i = Pool.ActiveEffects.Num() - 1; i >= 0; i--)
+		{
+			const UParticleSystemComponent* Component = Pool.ActiveEffects[i].Component;
+			if (Component == nullptr || !Component->IsActive())
+				ReleaseEffectAt(Pool, i);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_FXActive, ActiveEffectCount);
+}
+
+UParticleSystemComponent* UFXPoolSubsystem::SpawnEffectAtLocation(UParticleSystem* Template, EFXCategory Category, const FVector& Location, const FRotator& Rotation)
+{
+	if (Template == nullptr || Category >= EFXCategory::EFXC_MAX) return nullptr;
+
+	const FFXCategorySettings& Settings = ResolvedSettings[(uint8)Category];
+	FFXPool& Pool = FindOrAddPool(Template, Category);
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	if (ShouldMerge(Pool, Location, Now))
+	{
+		INC_DWORD_STAT(STAT_FXMerged);
+		return nullptr;
+	}
+
+	if (Pool.ActiveEffects.Num() >= Settings.MaxActive)
+	{
+		if (Settings.bDropWhenFull || Pool.ActiveEffects.Num() == 0)
+		{
+			INC_DWORD_STAT(STAT_FXDropped);
+			return nullptr;
+		}
+
+		RecycleOldest(Pool);
+	}
+	else if (!MakeRoomForEffect(Settings.Priority))
+	{
+		INC_DWORD_STAT(STAT_FXDropped);
+		return nullptr;
+	}
+
+	UParticleSystemComponent* Component = nullptr;
+	while (Component == nullptr && Pool.FreeComponents.Num() > 0)
+		Component = Pool.FreeComponents.Pop(false);
+
+	if (Component == nullptr)
+		Component = CreateComponent(Template);
+
+	if (Component == nullptr) return nullptr;
+
+	Component->SetWorldLocationAndRotation(Location, Rotation);
+	Component->ActivateSystem(true);
+
+	FActiveFX& ActiveFX = Pool.ActiveEffects.AddDefaulted_GetRef();
+	ActiveFX.Component = Component;
+	ActiveFX.Location = Location;
+	ActiveFX.SpawnTime = Now;
+
+	ActiveEffectCount++;
+	return Component;
+}
+
+void UFXPoolSubsystem::PrewarmEffect(UParticleSystem* Template, EFXCategory Category)
+{
+	if (Template == nullptr || Category >= EFXCategory::EFXC_MAX) return;
+
+	FFXPool& Pool = FindOrAddPool(Template, Category);
+	const int32 PrewarmCount = ResolvedSettings[(uint8)Category].PrewarmCount;
+
+	for (int32 i = Pool.FreeComponents.Num() + Pool.ActiveEffects.Num(); i < PrewarmCount; i++)
+	{
+		if (UParticleSystemComponent* Component = CreateComponent(Template))
+			Pool.FreeComponents.Add(Component);
+	}
+}
+
+FFXPool& UFXPoolSubsystem::FindOrAddPool(UParticleSystem* Template, EFXCategory Category)
+{
+	if (FFXPool* Pool = Pools.Find(Template))
+		return *Pool;
+
+	FFXPool& Pool = Pools.Add(Template);
+	Pool.Category = Category;
+	return Pool;
+}
+
+bool UFXPoolSubsystem::ShouldMerge(const FFXPool& Pool, const FVector& Location, double Now) const
+{
+	const FFXCategorySettings& Settings = ResolvedSettings[(uint8)Pool.Category];
+	if (Settings.MergeDistance <= 0.0f) return false;
+
+	const float MergeDistanceSq = FMath::Square(Settings.MergeDistance);
+
+	//Newest effects are at the back, stop once they are older than the merge window
+	for (int32 i = Pool.ActiveEffects.Num() - 1; i >= 0; i--)
+	{
+		const FActiveFX& ActiveFX = Pool.ActiveEffects[i];
+		if (Now - ActiveFX.SpawnTime > Settings.MergeTime) break;
+
+		if (FVector::DistSquared(ActiveFX.Location, Location) <= MergeDistanceSq)
+			return true;
+	}
+
+	return false;
+}
+
+bool UFXPoolSubsystem::MakeRoomForEffect(int32 Priority)
+{
+	if (MaxActiveEffects <= 0 || ActiveEffectCount < MaxActiveEffects) return true;
+
+	//Recycle the oldest effect of the lowest priority pool below the new effect
+	FFXPool* LowestPool = nullptr;
+	for (TPair<TObjectPtr<UParticleSystem>, FFXPool>& PoolPair : Pools)
+	{
+		FFXPool& Pool = PoolPair.Value;
+		if (Pool.ActiveEffects.Num() == 0) continue;
+
+		const int32 PoolPriority = ResolvedSettings[(uint8)Pool.Category].Priority;
+		if (PoolPriority >= Priority) continue;
+
+		if (LowestPool == nullptr || PoolPriority < ResolvedSettings[(uint8)LowestPool->Category].Priority)
+			LowestPool = &Pool;
+	}
+
+	if (LowestPool == nullptr) return false;
+
+	RecycleOldest(*LowestPool);
+	return true;
+}
+
+UParticleSystemComponent* UFXPoolSubsystem::CreateComponent(UParticleSystem* Template)
+{
+	UWorld* World = GetWorld();
+	AWorldSettings* WorldSettings = World ? World->GetWorldSettings() : nullptr;
+	if (WorldSettings == nullptr) return nullptr;
+
+	UParticleSystemComponent* Component = NewObject<UParticleSystemComponent>(WorldSettings);
+	Component->bAutoActivate = false;
+	Component->bAutoDestroy = false;
+	Component->SetTemplate(Template);
+	Component->RegisterComponentWithWorld(World);
+
+	INC_DWORD_STAT(STAT_FXComponentsCreated);
+	return Component;
+}
+
+void UFXPoolSubsystem::RecycleOldest(FFXPool& Pool)
+{
+	if (Pool.ActiveEffects.Num() == 0) return;
+
+	ReleaseEffectAt(Pool, 0);
+	INC_DWORD_STAT(STAT_FXRecycled);
+}
+
+void UFXPoolSubsystem::ReleaseEffectAt(FFXPool& Pool, int32 Index)
+{
+	if (UParticleSystemComponent* Component = Pool.ActiveEffects[Index].Component)
+	{
+		Component->DeactivateImmediate();
+		Pool.FreeComponents.Add(Component);
+	}
+
+	//Keep spawn order so the oldest effect stays at the front
+	Pool.ActiveEffects.RemoveAt(Index, 1, false);
+	ActiveEffectCount--;
+}
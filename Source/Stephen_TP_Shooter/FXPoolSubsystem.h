@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FXPoolSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+UENUM(BlueprintType)
+enum class EFXCategory : uint8
+{
+	EFXC_Beam		UMETA(DisplayName = "Beam"),
+	EFXC_Impact		UMETA(DisplayName = "Impact"),
+	EFXC_Blood		UMETA(DisplayName = "Blood"),
+	EFXC_Explosion	UMETA(DisplayName = "Explosion"),
+
+	EFXC_MAX		UMETA(DisplayName = "Default MAX")
+};
+
+USTRUCT()
+struct FFXCategorySettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config)
+	EFXCategory Category;
+
+	//Instances of one effect template in this category playing at once
+	UPROPERTY(Config)
+	int32 MaxActive;
+
+	//Components created for each effect template when it is first prewarmed
+	UPROPERTY(Config)
+	int32 PrewarmCount;
+
+	//When the world is over MaxActiveEffects, lower priority effects are dropped or recycled first
+	UPROPERTY(Config)
+	int32 Priority;
+
+	//A new effect this close to one of the same template spawned within MergeTime is skipped, 0 disables merging
+	UPROPERTY(Config)
+	float MergeDistance;
+
+	UPROPERTY(Config)
+	float MergeTime;
+
+	//At MaxActive the new effect is dropped instead of recycling the oldest instance
+	UPROPERTY(Config)
+	bool bDropWhenFull;
+
+	FFXCategorySettings()
+	{
+		Category = EFXCategory::EFXC_Impact;
+		MaxActive = 16;
+		PrewarmCount = 4;
+		Priority = 0;
+		MergeDistance = 0.0f;
+		MergeTime = 0.0f;
+		bDropWhenFull = false;
+	}
+};
+
+USTRUCT()
+struct FActiveFX
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UParticleSystemComponent> Component;
+
+	FVector Location;
+	double SpawnTime;
+
+	FActiveFX()
+	{
+		Location = FVector::ZeroVector;
+		SpawnTime = 0.0;
+	}
+};
+
+//Components of one effect template, active ones ordered oldest first
+USTRUCT()
+struct FFXPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UParticleSystemComponent>> FreeComponents;
+
+	UPROPERTY()
+	TArray<FActiveFX> ActiveEffects;
+
+	EFXCategory Category;
+
+	FFXPool()
+	{
+		Category = EFXCategory::EFXC_Impact;
+	}
+};
+
+/*
+* Reuses particle system components for one shot gameplay effects.
+* Each effect template keeps its own pool, capped per category. Under load, low priority effects
+* are merged with nearby recent ones, dropped, or recycled to make room for higher priority ones.
+*/
+UCLASS(Config = Game)
+class STEPHEN_TP_SHOOTER_API UFXPoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UFXPoolSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static UFXPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	//Pooled replacement for UGameplayStatics::SpawnEmitterAtLocation, returns nullptr when the effect was merged or dropped
+	static UParticleSystemComponent* SpawnEffect(const UObject* WorldContextObject, UParticleSystem* Template, EFXCategory Category, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator);
+
+	UParticleSystemComponent* SpawnEffectAtLocation(UParticleSystem* Template, EFXCategory Category, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator);
+
+	//Creates the category PrewarmCount components for Template ahead of its first use
+	void PrewarmEffect(UParticleSystem* Template, EFXCategory Category);
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetActiveEffectCount() const { return ActiveEffectCount; }
+
+private:
+	FFXPool& FindOrAddPool(UParticleSystem* Template, EFXCategory Category);
+
+	bool ShouldMerge(const FFXPool& Pool, const FVector& Location, double Now) const;
+
+	//Frees one global slot for an effect of Priority, false when the new effect should be dropped instead
+	bool MakeRoomForEffect(int32 Priority);
+
+	UParticleSystemComponent* CreateComponent(UParticleSystem* Template);
+	void RecycleOldest(FFXPool& Pool);
+	void ReleaseEffectAt(FFXPool& Pool, int32 Index);
+
+	//Total pooled effects playing at once across every template
+	UPROPERTY(Config)
+	int32 MaxActiveEffects;
+
+	UPROPERTY(Config)
+	TArray<FFXCategorySettings> CategorySettings;
+
+	//CategorySettings resolved by EFXCategory
+	FFXCategorySettings ResolvedSettings[(uint8)EFXCategory::EFXC_MAX];
+
+	UPROPERTY()
+	TMap<TObjectPtr<UParticleSystem>, FFXPool> Pools;
+
+	int32 ActiveEffectCount;
+};
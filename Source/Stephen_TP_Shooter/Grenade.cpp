@@ -4,6 +4,8 @@
 #include "Grenade.h"
 #include "ShooterCharacter.h"
 #include "ShooterPlayerController.h"
+#include "AudioVoiceSubsystem.h"
+#include "FXPoolSubsystem.h"
 
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
@@ -62,6 +64,9 @@ void AGrenade::InitGrenade()
 void AGrenade::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (UFXPoolSubsystem* FXPool = UFXPoolSubsystem::Get(this))
+		FXPool->PrewarmEffect(ExplodeParticles, EFXCategory::EFXC_Explosion);
 }
 
 void AGrenade::ExplosionTimerFinish()
@@ -72,10 +77,10 @@ void AGrenade::ExplosionTimerFinish()
 void AGrenade::Explode()
 {
 	if (ExplodeSound)
-		UGameplayStatics::PlaySoundAtLocation(this, ExplodeSound, GetActorLocation());
+		UAudioVoiceSubsystem::SpawnVoiceAtLocation(this, ExplodeSound, EVoiceCategory::EVC_Explosion, GetActorLocation());
 
 	if (ExplodeParticles)
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplodeParticles, GetActorLocation(), FRotator::ZeroRotator, true);
+		UFXPoolSubsystem::SpawnEffect(this, ExplodeParticles, EFXCategory::EFXC_Explosion, GetActorLocation());
 
 	TArray<AActor*> IgnoredActors;
 	IgnoredActors.Add(this);
@@ -3,20 +3,46 @@
 
 #include "GameFramework/CharacterMovementComponent.h"
 
-void UGruxAnimInstance::UpdateAnimationProperties(float DeltaTime)
+void UGruxAnimInstance::NativeInitializeAnimation()
+{
+	Super::NativeInitializeAnimation();
+
+	Enemy = Cast<AEnemy>(TryGetPawnOwner());
+}
+
+void UGruxAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
+	Super::NativeUpdateAnimation(DeltaSeconds);
+
 	if (Enemy == nullptr)
 		Enemy = Cast<AEnemy>(TryGetPawnOwner());
 
-	if (Enemy)
-	{
-		FVector Velocity = Enemy->GetVelocity();
-		Velocity.Z = 0.0f;
-
-		Speed = Velocity.Size();
-		bGreetedPlayer = Enemy->HasGreetedPlayer();
-		bAttacking = Enemy->IsAttacking();
-		bIsInAir = Enemy->GetCharacterMovement()->IsFalling();
-		TargetLocation = Enemy->GetTargetLocation();
-	}
+	Snapshot.bValid = Enemy != nullptr;
+	if (!Snapshot.bValid) return;
+
+	Snapshot.Velocity = Enemy->GetVelocity();
+	Snapshot.bGreetedPlayer = Enemy->HasGreetedPlayer();
+	Snapshot.bAttacking = Enemy->IsAttacking();
+	Snapshot.bIsFalling = Enemy->GetCharacterMovement()->IsFalling();
+	Snapshot.TargetLocation = Enemy->GetTargetLocation();
+}
+
+void UGruxAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	if (!Snapshot.bValid) return;
+
+	FVector Velocity = Snapshot.Velocity;
+	Velocity.Z = 0.0f;
+
+	Speed = Velocity.Size();
+	bGreetedPlayer = Snapshot.bGreetedPlayer;
+	bAttacking = Snapshot.bAttacking;
+	bIsInAir = Snapshot.bIsFalling;
+	TargetLocation = Snapshot.TargetLocation;
+}
+
+void UGruxAnimInstance::UpdateAnimationProperties(float DeltaTime)
+{
 }
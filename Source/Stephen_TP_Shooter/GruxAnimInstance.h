@@ -8,13 +8,39 @@
 
 class AEnemy;
 
+//Enemy state copied on the game thread, read by the thread safe animation update
+struct FGruxAnimSnapshot
+{
+	bool bValid;
+	FVector Velocity;
+	bool bGreetedPlayer;
+	bool bAttacking;
+	bool bIsFalling;
+	FVector TargetLocation;
+
+	FGruxAnimSnapshot()
+	{
+		bValid = false;
+		Velocity = FVector::ZeroVector;
+		bGreetedPlayer = false;
+		bAttacking = false;
+		bIsFalling = false;
+		TargetLocation = FVector::ZeroVector;
+	}
+};
+
 UCLASS()
 class STEPHEN_TP_SHOOTER_API UGruxAnimInstance : public UAnimInstance
 {
 	GENERATED_BODY()
 
 public:
-	UFUNCTION(BlueprintCallable)
+	virtual void NativeInitializeAnimation() override;
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+
+	//Kept so existing Blueprint graphs still compile, properties are now updated natively
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Properties are updated in NativeThreadSafeUpdateAnimation, remove this call from the Event Graph."))
 	void UpdateAnimationProperties(float DeltaTime);
 	
 private:
@@ -40,4 +66,6 @@ private:
 	//Location of Target that enemy is attacking
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement", meta = (AllowPrivateAccess = "true"))
 	FVector TargetLocation;
+
+	FGruxAnimSnapshot Snapshot;
 };
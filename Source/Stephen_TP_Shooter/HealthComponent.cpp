@@ -38,10 +38,7 @@ void UHealthComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	bIsDead = false;
-
-	Health = MaxHealth;
-	Armor = MaxArmor;
+	ResetHealth();
 }
 
 void UHealthComponent::OnTakeDamage(const float& DamageAmount, AActor* InstigatorActor, AController* InstigatorController)
@@ -100,4 +97,15 @@ void UHealthComponent::AddArmor(const float& ArmorAmount)
 	if (bIsDead) return;
 
 	Armor = FMath::Clamp(Armor + ArmorAmount, 0.0f, MaxArmor);
+}
+
+void UHealthComponent::ResetHealth()
+{
+	bIsDead = false;
+
+	Health = MaxHealth;
+	Armor = MaxArmor;
+
+	HealthInterp = 1.0f;
+	ArmorInterp = 1.0f;
 }
\ No newline at end of file
@@ -100,4 +100,8 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	void AddArmor(const float& ArmorAmount);
+
+	//Restores the component to its spawn state (used when an owner is reused from a pool)
+	UFUNCTION(BlueprintCallable)
+	void ResetHealth();
 };
@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HitNumberComponent.h"
+#include "HitNumberWidget.h"
+#include "Stephen_TP_Shooter.h"
+
+#include "GameFramework/PlayerController.h"
+
+UHitNumberComponent::UHitNumberComponent() :
+	HitNumberLifetime(1.5f),
+	PrewarmCount(8),
+	MaxHitNumbers(32)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	//Lay out after the camera has moved this frame so numbers do not lag behind
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UHitNumberComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (HitNumberWidgetClass == nullptr)
+	{
+		UE_LOG(LogGunBound, Log, TEXT("%s: HitNumberWidgetClass is not set, pooled hit numbers are disabled and Enemy Blueprints keep their own widgets"), *GetName());
+		return;
+	}
+
+	for (int32 i = FreeWidgets.Num(); i < FMath::Min(PrewarmCount, MaxHitNumbers); i++)
+	{
+		if (UHitNumberWidget* Widget = AcquireWidget())
+			FreeWidgets.Add(Widget);
+	}
+}
+
+void UHitNumberComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ClearHitNumbers();
+
+	for (UHitNumberWidget* Widget : FreeWidgets)
+	{
+		if (Widget)
+			Widget->RemoveFromParent();
+	}
+	FreeWidgets.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UHitNumberComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	if (PlayerController == nullptr) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = ActiveHitNumbers.Num() - 1; i >= 0; i--)
+	{
+		FActiveHitNumber& Entry = ActiveHitNumbers[i];
+		if (Entry.Widget == nullptr || Now >= Entry.ExpireTime)
+		{
+			ReleaseEntryAt(i);
+			continue;
+		}
+
+		FVector2D ScreenPosition;
+		const bool bOnScreen = PlayerController->ProjectWorldLocationToScreen(Entry.WorldLocation, ScreenPosition);
+
+		const ESlateVisibility DesiredVisibility = bOnScreen ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed;
+		if (Entry.Widget->GetVisibility() != DesiredVisibility)
+			Entry.Widget->SetVisibility(DesiredVisibility);
+
+		if (bOnScreen)
+			Entry.Widget->SetPositionInViewport(ScreenPosition);
+	}
+
+	if (ActiveHitNumbers.Num() == 0)
+		SetComponentTickEnabled(false);
+}
+
+void UHitNumberComponent::AddHitNumber(AActor* Target, int32 DamageToShow, FVector HitLocation, bool bHeadshot)
+{
+	const double ExpireTime = GetWorld()->GetTimeSeconds() + HitNumberLifetime;
+
+	//Pellets and splash hitting the same Target this frame show as one number
+	if (Target)
+	{
+		for (int32 i = ActiveHitNumbers.Num() - 1; i >= 0; i--)
+		{
+			FActiveHitNumber& Entry = ActiveHitNumbers[i];
+			if (Entry.HitFrame != GFrameCounter) break;
+			if (Entry.Target != Target) continue;
+
+			Entry.Damage += DamageToShow;
+			Entry.bHeadshot |= bHeadshot;
+			Entry.ExpireTime = ExpireTime;
+			Entry.Widget->OnHitNumberShown(Entry.Damage, Entry.bHeadshot);
+			return;
+		}
+	}
+
+	UHitNumberWidget* Widget = nullptr;
+	if (FreeWidgets.Num() > 0)
+		Widget = FreeWidgets.Pop(false);
+	else if (ActiveHitNumbers.Num() >= MaxHitNumbers && ActiveHitNumbers.Num() > 0)
+	{
+		//Entries are kept oldest first, so steal the front one
+		Widget = ActiveHitNumbers[0].Widget;
+		ActiveHitNumbers.RemoveAt(0, 1, false);
+	}
+	else
+		Widget = AcquireWidget();
+
+	if (Widget == nullptr) return;
+
+	FActiveHitNumber& Entry = ActiveHitNumbers.AddDefaulted_GetRef();
+	Entry.Widget = Widget;
+	Entry.Target = Target;
+	Entry.WorldLocation = HitLocation;
+	Entry.Damage = DamageToShow;
+	Entry.bHeadshot = bHeadshot;
+	Entry.ExpireTime = ExpireTime;
+	Entry.HitFrame = GFrameCounter;
+
+	//Positioned and made visible by the next layout pass
+	Widget->OnHitNumberShown(DamageToShow, bHeadshot);
+
+	SetComponentTickEnabled(true);
+}
+
+void UHitNumberComponent::ClearHitNumbers()
+{
+	for (int32 i = ActiveHitNumbers.Num() - 1; i >= 0; i--)
+		ReleaseEntryAt(i);
+}
+
+UHitNumberWidget* UHitNumberComponent::AcquireWidget()
+{
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	if (PlayerController == nullptr || HitNumberWidgetClass == nullptr) return nullptr;
+
+	UHitNumberWidget* Widget = CreateWidget<UHitNumberWidget>(PlayerController, HitNumberWidgetClass);
+	if (Widget == nullptr) return nullptr;
+
+	//Stays in the viewport for its whole life, pooling only toggles visibility
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	Widget->AddToViewport();
+
+	return Widget;
+}
+
+void UHitNumberComponent::ReleaseEntryAt(int32 Index)
+{
+	if (UHitNumberWidget* Widget = ActiveHitNumbers[Index].Widget)
+	{
+		Widget->SetVisibility(ESlateVisibility::Collapsed);
+		FreeWidgets.Add(Widget);
+	}
+
+	ActiveHitNumbers.RemoveAt(Index, 1, false);
+}
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HitNumberComponent.generated.h"
+
+class UHitNumberWidget;
+
+//One hit number on screen, following the world location it was spawned at
+USTRUCT()
+struct FActiveHitNumber
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UHitNumberWidget> Widget;
+
+	TWeakObjectPtr<AActor> Target;
+	FVector WorldLocation;
+	int32 Damage;
+	bool bHeadshot;
+
+	//World time after which the entry is returned to the pool
+	double ExpireTime;
+
+	//Frame the entry was last hit on, hits on the same target in the same frame are merged
+	uint64 HitFrame;
+
+	FActiveHitNumber()
+	{
+		WorldLocation = FVector::ZeroVector;
+		Damage = 0;
+		bHeadshot = false;
+		ExpireTime = 0.0;
+		HitFrame = 0;
+	}
+};
+
+/*
+* Draws every floating hit number for the owning player controller.
+* Widgets are pooled, positioned in one pass per frame and expired by timestamp.
+*/
+UCLASS( Config = Game, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class STEPHEN_TP_SHOOTER_API UHitNumberComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:	
+	UHitNumberComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	//Shows DamageToShow at HitLocation, merged into the Target's number if it was already hit this frame
+	UFUNCTION(BlueprintCallable)
+	void AddHitNumber(AActor* Target, int32 DamageToShow, FVector HitLocation, bool bHeadshot);
+
+	//Returns every active hit number to the pool
+	UFUNCTION(BlueprintCallable)
+	void ClearHitNumbers();
+
+private:
+	UHitNumberWidget* AcquireWidget();
+	void ReleaseEntryAt(int32 Index);
+
+	//Widget class used for every hit number, empty until a UHitNumberWidget Blueprint exists, Enemies then fall back to StoreHitNumber
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	TSubclassOf<UHitNumberWidget> HitNumberWidgetClass;
+
+	//Time before a hit number is removed from screen
+	UPROPERTY(EditDefaultsOnly, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	float HitNumberLifetime;
+
+	//Widgets created up front at BeginPlay
+	UPROPERTY(EditDefaultsOnly, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	int32 PrewarmCount;
+
+	//Max hit numbers on screen, the oldest one is reused when the cap is reached
+	UPROPERTY(EditDefaultsOnly, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	int32 MaxHitNumbers;
+
+	UPROPERTY()
+	TArray<FActiveHitNumber> ActiveHitNumbers;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UHitNumberWidget>> FreeWidgets;
+
+public:
+	FORCEINLINE int32 GetActiveHitNumberCount() const { return ActiveHitNumbers.Num(); }
+};
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HitNumberWidget.generated.h"
+
+/*
+* Base class for the floating damage number.
+* Instances are pooled by UHitNumberComponent, so the Blueprint must fully reset its text and animation in OnHitNumberShown.
+*/
+UCLASS()
+class STEPHEN_TP_SHOOTER_API UHitNumberWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	//Called every time the widget is taken from the pool, and again when another hit on the same target is merged into it
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnHitNumberShown(int32 DamageToShow, bool bHeadshot);
+};
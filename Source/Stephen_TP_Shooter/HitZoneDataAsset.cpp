@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HitZoneDataAsset.h"
+
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
+
+UHitZoneDataAsset::UHitZoneDataAsset() :
+	DefaultZone(EHitZone::EHZ_Torso)
+{
+	ResolveMultipliers();
+}
+
+void UHitZoneDataAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	ResolveMultipliers();
+}
+
+#if WITH_EDITOR
+void UHitZoneDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	ResolveMultipliers();
+
+	//Zones may have moved between bones, tables are rebuilt by the next enemy to begin play
+	BodyZoneCache.Empty();
+}
+#endif
+
+void UHitZoneDataAsset::ResolveMultipliers()
+{
+	for (uint8 i = 0; i < (uint8)EHitZone::EHZ_MAX; i++)
+		ResolvedMultipliers[i] = 1.0f;
+
+	for (const TPair<EHitZone, float>& Pair : ZoneDamageMultipliers)
+	{
+		if (Pair.Key >= EHitZone::EHZ_MAX) continue;
+
+		ResolvedMultipliers[(uint8)Pair.Key] = Pair.Value;
+	}
+}
+
+void UHitZoneDataAsset::CacheBodyZones(const UPhysicsAsset* PhysicsAsset, FName HeadBoneName) const
+{
+	if (PhysicsAsset == nullptr || BodyZoneCache.Contains(PhysicsAsset)) return;
+
+	//Body instances of a skeletal mesh are created in SkeletalBodySetups order, which is the body index reported by hits
+	TArray<EHitZone>& BodyZones = BodyZoneCache.Add(PhysicsAsset);
+	BodyZones.Reserve(PhysicsAsset->SkeletalBodySetups.Num());
+
+	for (const TObjectPtr<USkeletalBodySetup>& BodySetup : PhysicsAsset->SkeletalBodySetups)
+	{
+		const EHitZone* Zone = BodySetup ? BoneZones.Find(BodySetup->BoneName) : nullptr;
+		if (Zone == nullptr && BodySetup && !HeadBoneName.IsNone() && BodySetup->BoneName == HeadBoneName)
+		{
+			BodyZones.Add(EHitZone::EHZ_Head);
+			continue;
+		}
+
+		BodyZones.Add(Zone ? *Zone : DefaultZone);
+	}
+}
+
+EHitZone UHitZoneDataAsset::GetBodyZone(const UPhysicsAsset* PhysicsAsset, int32 BodyIndex) const
+{
+	const TArray<EHitZone>* BodyZones = BodyZoneCache.Find(PhysicsAsset);
+	if (BodyZones == nullptr || !BodyZones->IsValidIndex(BodyIndex)) return DefaultZone;
+
+	return (*BodyZones)[BodyIndex];
+}
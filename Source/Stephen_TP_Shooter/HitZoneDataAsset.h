@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "UObject/ObjectKey.h"
+#include "HitZone.h"
+#include "HitZoneDataAsset.generated.h"
+
+class UPhysicsAsset;
+
+/**
+ * Hit zones and zone damage multipliers of one enemy type.
+ * The zone of every physics asset body is resolved once per physics asset, so a hit looks its zone up by body index.
+ */
+UCLASS()
+class STEPHEN_TP_SHOOTER_API UHitZoneDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UHitZoneDataAsset();
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	//Builds the body index to zone table of PhysicsAsset, called when an enemy using it begins play.
+	//HeadBoneName is treated as EHZ_Head when BoneZones has no entry for it, so a missing head entry never disables headshots
+	void CacheBodyZones(const UPhysicsAsset* PhysicsAsset, FName HeadBoneName) const;
+
+	//Zone of the body at BodyIndex, DefaultZone when the physics asset was not cached or the index is out of range
+	EHitZone GetBodyZone(const UPhysicsAsset* PhysicsAsset, int32 BodyIndex) const;
+
+	FORCEINLINE float GetDamageMultiplier(EHitZone Zone) const { return Zone < EHitZone::EHZ_MAX ? ResolvedMultipliers[(uint8)Zone] : 1.0f; }
+
+	//Zone of each physics asset body, keyed by the bone the body is bound to
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Hit Zones")
+	TMap<FName, EHitZone> BoneZones;
+
+	//Zone of bodies missing from BoneZones
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Hit Zones")
+	EHitZone DefaultZone;
+
+	//Damage multiplier per zone, zones missing here deal unscaled damage
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Hit Zones")
+	TMap<EHitZone, float> ZoneDamageMultipliers;
+
+private:
+	void ResolveMultipliers();
+
+	//ZoneDamageMultipliers resolved by EHitZone
+	float ResolvedMultipliers[(uint8)EHitZone::EHZ_MAX];
+
+	//Body index to zone, one table per physics asset used by this enemy type
+	mutable TMap<TObjectKey<UPhysicsAsset>, TArray<EHitZone>> BodyZoneCache;
+};
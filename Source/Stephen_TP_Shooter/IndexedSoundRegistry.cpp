@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "IndexedSoundRegistry.h"
+
+#include "Sound/SoundCue.h"
+
+FIndexedSoundRegistry::FIndexedSoundRegistry()
+{
+	FMemory::Memzero(Sounds);
+}
+
+void FIndexedSoundRegistry::Build(const TMap<FString, TObjectPtr<USoundCue>>& AudioMap)
+{
+	FMemory::Memzero(Sounds);
+	UnindexedSounds.Reset();
+
+	for (const TPair<FString, TObjectPtr<USoundCue>>& AudioPair : AudioMap)
+	{
+		const ESoundType SoundType = GetSoundType(AudioPair.Key);
+		if (SoundType == ESoundType::EST_MAX)
+		{
+			UnindexedSounds.Add(AudioPair.Key, AudioPair.Value);
+			continue;
+		}
+
+		Sounds[(uint8)SoundType] = AudioPair.Value;
+	}
+}
+
+USoundCue* FIndexedSoundRegistry::Find(const FString& SoundName) const
+{
+	const ESoundType SoundType = GetSoundType(SoundName);
+	if (SoundType != ESoundType::EST_MAX)
+		return Get(SoundType);
+
+	USoundCue* const* Sound = UnindexedSounds.Find(SoundName);
+	return Sound ? *Sound : nullptr;
+}
+
+ESoundType FIndexedSoundRegistry::GetSoundType(const FString& SoundName)
+{
+	//Built once from the enum, "HitSound" -> EST_HitSound
+	static const TMap<FString, ESoundType> SoundTypesByName = []()
+	{
+		TMap<FString, ESoundType> Result;
+
+		const UEnum* SoundTypeEnum = StaticEnum<ESoundType>();
+		for (uint8 i = 0; i < (uint8)ESoundType::EST_MAX; i++)
+		{
+			FString Name = SoundTypeEnum->GetNameStringByValue(i);
+			Name.RemoveFromStart(TEXT("EST_"));
+			Result.Add(Name, (ESoundType)i);
+		}
+
+		return Result;
+	}();
+
+	const ESoundType* SoundType = SoundTypesByName.Find(SoundName);
+	return SoundType ? *SoundType : ESoundType::EST_MAX;
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SoundType.h"
+
+class USoundCue;
+
+/*
+* AudioMap resolved once into an array indexed by ESoundType, so playing a sound is an array read instead of hashing an FString.
+* Keys of the form "<Name>" map to ESoundType::EST_<Name>. Keys with no matching ESoundType stay reachable by name for Blueprints.
+* Does not hold references itself, the AudioMap it was built from must outlive it.
+*/
+struct STEPHEN_TP_SHOOTER_API FIndexedSoundRegistry
+{
+	FIndexedSoundRegistry();
+
+	void Build(const TMap<FString, TObjectPtr<USoundCue>>& AudioMap);
+
+	FORCEINLINE USoundCue* Get(ESoundType SoundType) const { return SoundType < ESoundType::EST_MAX ? Sounds[(uint8)SoundType] : nullptr; }
+
+	//Slow path for Blueprint callers that still pass the AudioMap key
+	USoundCue* Find(const FString& SoundName) const;
+
+	//ESoundType for an AudioMap key, EST_MAX when there is none
+	static ESoundType GetSoundType(const FString& SoundName);
+
+private:
+	USoundCue* Sounds[(uint8)ESoundType::EST_MAX];
+
+	TMap<FString, USoundCue*> UnindexedSounds;
+};
@@ -2,17 +2,50 @@
 
 
 #include "Item.h"
+#include "Stephen_TP_Shooter.h"
 #include "Components/BoxComponent.h"
 #include "Components/SphereComponent.h"
 #include "Components/WidgetComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Curves/CurveFloat.h"
 #include "ShooterCharacter.h"
-#include "Kismet/GameplayStatics.h"
+#include "AudioVoiceSubsystem.h"
+#include "ItemDefinitionSubsystem.h"
+#include "ItemPulseSubsystem.h"
 #include "Sound/SoundCue.h"
 #include "Curves/CurveVector.h"
 #include "GameFramework/RotatingMovementComponent.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Physics State Updates"), STAT_ItemPhysicsStateUpdates, STATGROUP_GunBound);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Physics State Updates Skipped"), STAT_ItemPhysicsStateUpdatesSkipped, STATGROUP_GunBound);
+
+namespace
+{
+	//Collision and visibility of the item components for one EItemState
+	struct FItemStateProperties
+	{
+		FName MeshProfile;
+		FName AreaSphereProfile;
+		FName CollisionBoxProfile;
+		bool bSimulatePhysics;
+		bool bMeshVisible;
+		bool bRotate;
+		bool bHidePickupWidget;
+	};
+
+	//Indexed by EItemState
+	const FItemStateProperties ItemStateProperties[] =
+	{
+		/* Pickup */			{ ItemCollisionProfile::NoCollision, ItemCollisionProfile::Area,		ItemCollisionProfile::TraceBox,		false, true,  true,  false },
+		/* EquipInterping */	{ ItemCollisionProfile::NoCollision, ItemCollisionProfile::NoCollision, ItemCollisionProfile::NoCollision, false, true,  false, true },
+		/* PickedUp */			{ ItemCollisionProfile::NoCollision, ItemCollisionProfile::NoCollision, ItemCollisionProfile::NoCollision, false, true,  false, true },
+		/* Equipped */			{ ItemCollisionProfile::NoCollision, ItemCollisionProfile::NoCollision, ItemCollisionProfile::NoCollision, false, true,  false, true },
+		/* Falling */			{ ItemCollisionProfile::Falling,	 ItemCollisionProfile::NoCollision, ItemCollisionProfile::NoCollision, true,  true,  true,  false },
+		/* InActive */			{ ItemCollisionProfile::NoCollision, ItemCollisionProfile::NoCollision, ItemCollisionProfile::NoCollision, false, false, false, true },
+	};
+	static_assert(UE_ARRAY_COUNT(ItemStateProperties) == static_cast<int32>(EItemState::EIS_MAX), "ItemStateProperties must cover every EItemState");
+}
+
 // Sets default values
 AItem::AItem() :
 	ItemName(FString("Default")),
@@ -42,6 +75,7 @@ AItem::AItem() :
 	SlotIndex(0),
 	bCharacterInventoryFull(false),
 
+	RarityDefinition(nullptr),
 	bIsInteractable(true)
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
@@ -52,14 +86,14 @@ AItem::AItem() :
 
 	CollisionBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Collision Box"));
 	CollisionBox->SetupAttachment(ItemMesh);
-	CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	CollisionBox->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
+	CollisionBox->SetCollisionProfileName(ItemCollisionProfile::TraceBox);
 
 	PickupWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("Pickup Widget"));
 	PickupWidget->SetupAttachment(GetRootComponent());
 
 	AreaSphere = CreateDefaultSubobject<USphereComponent>(TEXT("Area Sphere"));
 	AreaSphere->SetupAttachment(GetRootComponent());
+	AreaSphere->SetCollisionProfileName(ItemCollisionProfile::Area);
 
 	RotatingComponent = CreateDefaultSubobject<URotatingMovementComponent>(TEXT("RotatingComponent"));
 }
@@ -73,8 +107,8 @@ void AItem::BeginPlay()
 	if(PickupWidget)
 		PickupWidget->SetVisibility(false);
 
-	//Based on item rarity
-	SetActiveStars();
+	//Items placed in the level are copied into the game world without running construction again
+	ResolveRarityDefinition();
 
 	AreaSphere->OnComponentBeginOverlap.AddDynamic(this, &AItem::OnSphereOverlap);
 	AreaSphere->OnComponentEndOverlap.AddDynamic(this, &AItem::OnSphereEndOverlap);
@@ -85,8 +119,16 @@ void AItem::BeginPlay()
 	//Init Custom Depth (Default: Disabled)
 	InitCustomDepth();
 
-	//Starts the Pulse Curve Timer in Loop
-	StartPulseTimer();
+	//Idle pickups pulse through the shared driver
+	UpdatePulseRegistration();
+}
+
+void AItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UItemPulseSubsystem* ItemPulseSubsystem = UItemPulseSubsystem::Get(this))
+		ItemPulseSubsystem->UnregisterItem(this);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AItem::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -109,224 +151,79 @@ void AItem::OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor*
 	}
 }
 
-void AItem::SetActiveStars()
+void AItem::ResolveRarityDefinition()
 {
-	for (int32 i = 0; i <= 5; i++)
-	{
-		//0th element isn't used
-		ActiveStars.Add(false);
-	}
-
-	switch (ItemRarity)
-	{
-	case EItemRarity::EIR_Damaged:
-		ActiveStars[1] = true;
-		break;
-	case EItemRarity::EIR_Common:
-		ActiveStars[1] = true;
-		ActiveStars[2] = true;
-		break;
-	case EItemRarity::EIR_Uncommon:
-		ActiveStars[1] = true;
-		ActiveStars[2] = true;
-		ActiveStars[3] = true;
-		break;
-	case EItemRarity::EIR_Rare:
-		ActiveStars[1] = true;
-		ActiveStars[2] = true;
-		ActiveStars[3] = true;
-		ActiveStars[4] = true;
-		break;
-	case EItemRarity::EIR_Legendary:
-		ActiveStars[1] = true;
-		ActiveStars[2] = true;
-		ActiveStars[3] = true;
-		ActiveStars[4] = true;
-		ActiveStars[5] = true;
-		break;
-	case EItemRarity::EIR_MAX:
-		break;
-	default:
-		break;
-	}
+	UItemDefinitionSubsystem* ItemDefinitionSubsystem = UItemDefinitionSubsystem::Get(this);
+	RarityDefinition = ItemDefinitionSubsystem ? &ItemDefinitionSubsystem->GetRarityDefinition(ItemRarity) : nullptr;
 }
 
-void AItem::SetItemProperties(EItemState State)
+TArray<bool> AItem::GetActiveStars() const
 {
-	switch (State)
-	{
-	case EItemState::EIS_Pickup:
-		if (ItemMesh)
-		{
-			ItemMesh->SetSimulatePhysics(false);
-			ItemMesh->SetEnableGravity(false);
-			ItemMesh->SetVisibility(true);
-			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		if (AreaSphere)
-		{
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-		}
-
-		if (CollisionBox)
-		{
-			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			CollisionBox->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
-			CollisionBox->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		}
-
-		if (RotatingComponent)
-			RotatingComponent->Activate();
-		break;
-
-	case EItemState::EIS_EquipInterping:
-
-		if(PickupWidget)
-			PickupWidget->SetVisibility(false);
-
-		if (ItemMesh)
-		{
-			ItemMesh->SetSimulatePhysics(false);
-			ItemMesh->SetEnableGravity(false);
-			ItemMesh->SetVisibility(true);
-			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		if (AreaSphere)
-		{
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		if (CollisionBox)
-		{
-			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		if (RotatingComponent)
-			RotatingComponent->Deactivate();
-		break;
-
-	case EItemState::EIS_PickedUp:
-		if (PickupWidget)
-			PickupWidget->SetVisibility(false);
-
-		if (ItemMesh)
-		{
-			ItemMesh->SetSimulatePhysics(false);
-			ItemMesh->SetEnableGravity(false);
-			ItemMesh->SetVisibility(true);
-			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		if (AreaSphere)
-		{
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		if (CollisionBox)
-		{
-			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		if (RotatingComponent)
-			RotatingComponent->Deactivate();
-		break;
-	
-	case EItemState::EIS_Equipped:
-
-		if (PickupWidget)
-			PickupWidget->SetVisibility(false);
-
-		if (ItemMesh)
-		{
-			ItemMesh->SetSimulatePhysics(false);
-			ItemMesh->SetEnableGravity(false);
-			ItemMesh->SetVisibility(true);
-			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
-
-		if (AreaSphere)
-		{
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
+	return RarityDefinition ? RarityDefinition->ActiveStars : TArray<bool>();
+}
 
-		if (CollisionBox)
-		{
-			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
+const FItemRarityTable* AItem::FindRarityRow() const
+{
+	return RarityDefinition ? &RarityDefinition->Row : UItemDefinitionSubsystem::FindRarityRow(ItemRarity);
+}
 
-		if (RotatingComponent)
-			RotatingComponent->Deactivate();
-		break;
+void AItem::SetItemProperties(EItemState State)
+{
+	if (State == EItemState::EIS_MAX) return;
 
-	case EItemState::EIS_Falling:
+	const FItemStateProperties& Properties = ItemStateProperties[static_cast<int32>(State)];
 
-		if (ItemMesh)
-		{
-			ItemMesh->SetSimulatePhysics(true);
-			ItemMesh->SetVisibility(true);
-			ItemMesh->SetEnableGravity(true);
-			ItemMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			ItemMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldStatic, ECollisionResponse::ECR_Block);
-		}
+	if (Properties.bHidePickupWidget && PickupWidget)
+		PickupWidget->SetVisibility(false);
 
-		if (AreaSphere)
-		{
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
+	if (ItemMesh)
+	{
+		ItemMesh->SetVisibility(Properties.bMeshVisible);
+		ApplyCollisionProfile(ItemMesh, Properties.MeshProfile, Properties.bSimulatePhysics);
+	}
 
-		if (CollisionBox)
-		{
-			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
+	ApplyCollisionProfile(AreaSphere, Properties.AreaSphereProfile);
+	ApplyCollisionProfile(CollisionBox, Properties.CollisionBoxProfile);
 
-		if (RotatingComponent)
+	if (RotatingComponent)
+	{
+		if (Properties.bRotate)
 			RotatingComponent->Activate();
-		break;
+		else
+			RotatingComponent->Deactivate();
+	}
+}
 
-	case EItemState::EIS_InActive:
-		if (PickupWidget)
-			PickupWidget->SetVisibility(false);
+void AItem::ApplyCollisionProfile(UPrimitiveComponent* Component, FName ProfileName, bool bSimulatePhysics)
+{
+	if (Component == nullptr) return;
 
-		if (ItemMesh)
-		{
-			ItemMesh->SetSimulatePhysics(false);
-			ItemMesh->SetEnableGravity(false);
-			ItemMesh->SetVisibility(false);
-			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
+	//Stop simulating first so the profile change does not rebuild a simulating body
+	if (!bSimulatePhysics && Component->BodyInstance.bSimulatePhysics)
+	{
+		Component->SetSimulatePhysics(false);
+		INC_DWORD_STAT(STAT_ItemPhysicsStateUpdates);
+	}
 
-		if (AreaSphere)
-		{
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
+	//Object type, responses and collision enabled are applied together with a single physics state update
+	if (Component->GetCollisionProfileName() != ProfileName)
+	{
+		Component->SetCollisionProfileName(ProfileName);
+		INC_DWORD_STAT(STAT_ItemPhysicsStateUpdates);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_ItemPhysicsStateUpdatesSkipped);
+	}
 
-		if (CollisionBox)
-		{
-			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		}
+	if (Component->IsGravityEnabled() != bSimulatePhysics)
+		Component->SetEnableGravity(bSimulatePhysics);
 
-		if (RotatingComponent)
-			RotatingComponent->Deactivate();
-		break;
+	//Start simulating last, once the profile has enabled physics collision
+	if (bSimulatePhysics && !Component->BodyInstance.bSimulatePhysics)
+	{
+		Component->SetSimulatePhysics(true);
+		INC_DWORD_STAT(STAT_ItemPhysicsStateUpdates);
 	}
 }
 
@@ -423,14 +320,14 @@ void AItem::PlayPickupSound(bool bForcePlaySound)
 	{
 		if (bForcePlaySound)
 		{
-			if (PickupSound)
-				UGameplayStatics::PlaySound2D(this, PickupSound);
+			if (GetPickupSound())
+				UAudioVoiceSubsystem::SpawnVoice2D(this, GetPickupSound(), EVoiceCategory::EVC_Pickup);
 		}
 		else if (Character->ShouldPlayPickupSound())
 		{
 			Character->StartPickupSoundTimer();
-			if(PickupSound)
-				UGameplayStatics::PlaySound2D(this, PickupSound);
+			if (GetPickupSound())
+				UAudioVoiceSubsystem::SpawnVoice2D(this, GetPickupSound(), EVoiceCategory::EVC_Pickup);
 		}
 	}
 }
@@ -441,14 +338,14 @@ void AItem::PlayEquipSound(bool bForcedPlaySound)
 	{
 		if (bForcedPlaySound)
 		{
-			if (EquippedSound)
-				UGameplayStatics::PlaySound2D(this, EquippedSound);
+			if (GetEquippedSound())
+				UAudioVoiceSubsystem::SpawnVoice2D(this, GetEquippedSound(), EVoiceCategory::EVC_Pickup);
 		}
 		else if (Character->ShouldPlayEquipSound())
 		{
 			Character->StartEquipSoundTimer();
-			if (EquippedSound)
-				UGameplayStatics::PlaySound2D(this, EquippedSound);
+			if (GetEquippedSound())
+				UAudioVoiceSubsystem::SpawnVoice2D(this, GetEquippedSound(), EVoiceCategory::EVC_Pickup);
 		}
 	}
 }
@@ -473,86 +370,59 @@ void AItem::InitCustomDepth()
 //Called before the game starts
 void AItem::OnConstruction(const FTransform& Transform)
 {
-	//Load the data in the Item Rarity Table
-	//Path to Data Table
-	FString RarityTablePath = TEXT("/Script/Engine.DataTable'/Game/_Game/DataTable/ItemRarityTable.ItemRarityTable'");
-	UDataTable* RarityTableObject = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *RarityTablePath));
-	if (RarityTableObject)
-	{
-		FItemRarityTable* RarityRow = nullptr;
-		switch (ItemRarity)
-		{
-		case EItemRarity::EIR_Damaged:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Damaged"), TEXT(""));
-			break;
-		case EItemRarity::EIR_Common:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Common"), TEXT(""));
-			break;
-		case EItemRarity::EIR_Uncommon:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("UnCommon"), TEXT(""));
-			break;
-		case EItemRarity::EIR_Rare:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Rare"), TEXT(""));
-			break;
-		case EItemRarity::EIR_Legendary:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Legendary"), TEXT(""));
-			break;
-		}
+	ResolveRarityDefinition();
 
-		if (RarityRow)
-		{
-			GlowColor = RarityRow->GlowColor;
-			LightColor = RarityRow->LightColor;
-			DarkColor = RarityRow->DarkColor;
-			NumStars = RarityRow->StarsNum;
-			IconBackground = RarityRow->IconBackground;
-
-			if (GetItemMesh())
-				GetItemMesh()->SetCustomDepthStencilValue(RarityRow->CustomDepthStencilVal);
-		}
-	}
+	const FItemRarityTable* RarityRow = FindRarityRow();
+	if (GetItemMesh() && RarityRow)
+		GetItemMesh()->SetCustomDepthStencilValue(RarityRow->CustomDepthStencilVal);
 
 	if (MaterialInstance)
 	{
 		DynamicMaterialInstance = UMaterialInstanceDynamic::Create(MaterialInstance, this);
-		DynamicMaterialInstance->SetVectorParameterValue(TEXT("FresnelColor"), GlowColor);
+		DynamicMaterialInstance->SetVectorParameterValue(TEXT("FresnelColor"), RarityRow ? RarityRow->GlowColor : FLinearColor::White);
 
 		ItemMesh->SetMaterial(MaterialIndex, DynamicMaterialInstance);
 		EnableGlowMaterial();
 	}
 }
 
-void AItem::UpdatePulse()
+void AItem::UpdateInterpPulse()
 {
-	float ElaspedTime{};
-	FVector CurveVal{};
-	switch (ItemState)
-	{
-	case EItemState::EIS_Pickup:		
-		if (PulseCurve)
-		{
-			ElaspedTime = GetWorldTimerManager().GetTimerElapsed(PulseTimer);
-			CurveVal = PulseCurve->GetVectorValue(ElaspedTime);			
-		}
-		break;
+	if (InterpPulseCurve == nullptr) return;
 
-	case EItemState::EIS_EquipInterping:
-		if (InterpPulseCurve)
-		{
-			ElaspedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpTimer);
-			CurveVal = InterpPulseCurve->GetVectorValue(ElaspedTime);
-		}
-		break;	
+	const float ElaspedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpTimer);
+	ApplyPulse(InterpPulseCurve->GetVectorValue(ElaspedTime));
+}
+
+void AItem::ApplyPulse(const FVector& CurveValue)
+{
+	if (DynamicMaterialInstance)
+	{
+		DynamicMaterialInstance->SetScalarParameterValue(TEXT("GlowAmount"), CurveValue.X * GlowAmount);
+		DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelExponent"), CurveValue.Y * FresnelExponent);
+		DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelReflectFraction"), CurveValue.Z * FresnelReflectFraction);
 	}
+}
 
+void AItem::SetSharedPulse(bool bShared)
+{
 	if (DynamicMaterialInstance)
 	{
-		DynamicMaterialInstance->SetScalarParameterValue(TEXT("GlowAmount"), CurveVal.X * GlowAmount);
-		DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelExponent"), CurveVal.Y * FresnelExponent);
-		DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelReflectFraction"), CurveVal.Z * FresnelReflectFraction);
+		DynamicMaterialInstance->SetScalarParameterValue(TEXT("SharedPulseAlpha"), bShared ? 1.0f : 0.0f);
 	}
 }
 
+void AItem::UpdatePulseRegistration()
+{
+	UItemPulseSubsystem* ItemPulseSubsystem = UItemPulseSubsystem::Get(this);
+	if (ItemPulseSubsystem == nullptr) return;
+
+	if (ItemState == EItemState::EIS_Pickup)
+		ItemPulseSubsystem->RegisterItem(this);
+	else
+		ItemPulseSubsystem->UnregisterItem(this);
+}
+
 void AItem::EnableGlowMaterial()
 {
 	if (DynamicMaterialInstance)
@@ -576,25 +446,20 @@ void AItem::Tick(float DeltaTime)
 
 	ItemInterp(DeltaTime);
 
-	//Get Curve Values from Pulse Curve and set Dynamic Material Instance parameters
-	UpdatePulse();
-}
-
-void AItem::ResetPulseTimer()
-{
-	StartPulseTimer();
-}
-
-void AItem::StartPulseTimer()
-{
-	if (ItemState == EItemState::EIS_Pickup)
-		GetWorldTimerManager().SetTimer(PulseTimer, this, &AItem::ResetPulseTimer, PulseCurveTime);
+	//Idle pickups are pulsed by UItemPulseSubsystem, only the interping item drives its own parameters
+	if (ItemState == EItemState::EIS_EquipInterping)
+		UpdateInterpPulse();
 }
 
 void AItem::SetItemState(EItemState State)
 {
+	//Clear the last interp pulse value once the item lands
+	if (ItemState == EItemState::EIS_EquipInterping && State != EItemState::EIS_EquipInterping)
+		ApplyPulse(FVector::ZeroVector);
+
 	ItemState = State;
 	SetItemProperties(State);
+	UpdatePulseRegistration();
 }
 
 void AItem::StartItemCurve(AShooterCharacter* Char, bool bForcePlaySound)
@@ -616,7 +481,6 @@ void AItem::StartItemCurve(AShooterCharacter* Char, bool bForcePlaySound)
 
 	SetItemState(EItemState::EIS_EquipInterping);
 
-	GetWorldTimerManager().ClearTimer(PulseTimer);
 	GetWorldTimerManager().SetTimer(ItemInterpTimer, FTimerDelegate::CreateLambda([&] { FinishInterping(Char); }), ZCurveTime, false);
 
 	const float CameraRotYaw = Character->GetFollowCamera()->GetComponentRotation().Yaw;
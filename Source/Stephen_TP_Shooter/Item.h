@@ -17,6 +17,16 @@ class USoundCue;
 class UDataTable;
 class AShooterCharacter;
 
+//Collision profiles from DefaultEngine.ini used by item state transitions
+namespace ItemCollisionProfile
+{
+	inline const FName NoCollision(TEXT("ItemNoCollision"));
+	inline const FName Area(TEXT("ItemArea"));
+	inline const FName TraceBox(TEXT("ItemTraceBox"));
+	inline const FName Falling(TEXT("ItemFalling"));
+	inline const FName BlockAll(TEXT("BlockAllDynamic"));
+}
+
 UENUM(BlueprintType)
 enum class EItemRarity : uint8
 {
@@ -93,6 +103,20 @@ struct FItemRarityTable : public FTableRowBase
 	{}
 };
 
+//Rarity row plus the star flags derived from it, built once per rarity by UItemDefinitionSubsystem and shared by every item
+USTRUCT()
+struct FItemRarityDefinition
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FItemRarityTable Row;
+
+	//Index 0 is unused, stars 1 to 5 are lit by rarity
+	UPROPERTY()
+	TArray<bool> ActiveStars;
+};
+
 UCLASS()
 class STEPHEN_TP_SHOOTER_API AItem : public AActor
 {
@@ -104,6 +128,8 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void Tick(float DeltaTime) override;
 
 protected:
@@ -117,12 +143,18 @@ protected:
 	UFUNCTION()
 	void OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
-	//Number of stars active based on rarity
-	void SetActiveStars();
+	//Points RarityDefinition at the shared entry for ItemRarity, left null in editor worlds
+	void ResolveRarityDefinition();
+
+	//Row of ItemRarity, read from the table itself in editor worlds which have no RarityDefinition
+	const FItemRarityTable* FindRarityRow() const;
 
 	//Sets properties of item components based on state
 	virtual void SetItemProperties(EItemState State);
 
+	//Applies a collision profile and simulate flag in one pass, skipping whatever already matches
+	static void ApplyCollisionProfile(UPrimitiveComponent* Component, FName ProfileName, bool bSimulatePhysics = false);
+
 	//Handles Item Interpolation
 	void ItemInterp(float DeltaTime);
 
@@ -133,9 +165,11 @@ protected:
 
 	virtual void OnConstruction(const FTransform& Transform) override;	
 
-	void UpdatePulse();
-	void ResetPulseTimer();
-	void StartPulseTimer();
+	//Drives the glow from InterpPulseCurve while the item flies to the character
+	void UpdateInterpPulse();
+
+	//Idle pickups are pulsed by UItemPulseSubsystem, every other state is not
+	void UpdatePulseRegistration();
 
 private:
 	//Skeletal Mesh for the Item
@@ -169,9 +203,6 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	EItemRarity ItemRarity;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
-	TArray<bool> ActiveStars;
-
 	//State of the item
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	EItemState ItemState;
@@ -244,10 +275,8 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UCurveVector> PulseCurve;
 
-	FTimerHandle PulseTimer;
-
-	//Time for PulseTimer
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
+	//No longer read, idle pickups loop over UItemPulseSubsystem PulsePeriod. Only kept so old Blueprint reads still compile
+	UPROPERTY(BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true", DeprecatedProperty, DeprecationMessage = "Ignored, the pulse loop length is PulsePeriod in the ItemPulseSubsystem section of DefaultGame.ini"))
 	float PulseCurveTime;
 
 	//X-Axis from PulseCurve
@@ -285,25 +314,8 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Data Table", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UDataTable> ItemRarityDataTable;
 
-	//Color in Glow Material
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rarity", meta = (AllowPrivateAccess = "true"))
-	FLinearColor GlowColor;
-
-	//Color in pickup widget
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rarity", meta = (AllowPrivateAccess = "true"))
-	FLinearColor LightColor;
-
-	//Color in pickup widget
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rarity", meta = (AllowPrivateAccess = "true"))
-	FLinearColor DarkColor;
-
-	//Num of Stars in Pickup Widget
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rarity", meta = (AllowPrivateAccess = "true"))
-	int32 NumStars;
-
-	//Background Icon for Inventory
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rarity", meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UTexture2D> IconBackground;
+	//Glow, widget colors, stars and icon background shared by every item of this rarity, owned by UItemDefinitionSubsystem
+	const FItemRarityDefinition* RarityDefinition;
 
 protected:
 	//Pointer to character
@@ -329,6 +341,14 @@ public:
 	void EnableGlowMaterial();
 	void DisableGlowMaterial();
 
+	//Scales the pulse curve value by the glow parameters and writes it into the dynamic material
+	void ApplyPulse(const FVector& CurveValue);
+
+	//Switches the dynamic material between the shared pulse collection and its own pulse parameters
+	void SetSharedPulse(bool bShared);
+
+	FORCEINLINE UCurveVector* GetPulseCurve() const { return PulseCurve; }
+
 	FORCEINLINE bool IsInteractable() const { return bIsInteractable; }
 
 	FORCEINLINE TObjectPtr<UWidgetComponent> GetPickupWidget() const { return PickupWidget; }
@@ -342,8 +362,18 @@ public:
 
 	FORCEINLINE TObjectPtr<USkeletalMeshComponent> GetItemMesh() const { return ItemMesh; }
 
-	FORCEINLINE TObjectPtr<USoundCue> GetPickupSound() const { return PickupSound; }
-	FORCEINLINE TObjectPtr<USoundCue> GetEquippedSound() const { return EquippedSound; }
+	//Weapons read these from their shared definition instead of per instance copies
+	virtual USoundCue* GetPickupSound() const { return PickupSound; }
+	virtual USoundCue* GetEquippedSound() const { return EquippedSound; }
+
+	UFUNCTION(BlueprintPure, Category = "Item Properties")
+	virtual FString GetItemName() const { return ItemName; }
+
+	UFUNCTION(BlueprintPure, Category = "Item Properties")
+	virtual UTexture2D* GetItemIcon() const { return IconItem; }
+
+	UFUNCTION(BlueprintPure, Category = "Item Properties")
+	virtual UTexture2D* GetAmmoIcon() const { return AmmoIcon; }
 
 	FORCEINLINE int32 GetItemCount() const { return AmmoCount; }
 
@@ -368,7 +398,23 @@ public:
 	FORCEINLINE TObjectPtr<UMaterialInstanceDynamic> GetDynamicMaterialInstance() const { return DynamicMaterialInstance; }
 	FORCEINLINE void SetDynamicMaterialInstance(TObjectPtr<UMaterialInstanceDynamic> NewMatInstance) { DynamicMaterialInstance = NewMatInstance; }
 
-	FORCEINLINE FLinearColor GetGlowColor() const { return GlowColor; }
+	UFUNCTION(BlueprintPure, Category = "Rarity")
+	FORCEINLINE FLinearColor GetGlowColor() const { return RarityDefinition ? RarityDefinition->Row.GlowColor : FLinearColor::White; }
+
+	UFUNCTION(BlueprintPure, Category = "Rarity")
+	FORCEINLINE FLinearColor GetLightColor() const { return RarityDefinition ? RarityDefinition->Row.LightColor : FLinearColor::White; }
+
+	UFUNCTION(BlueprintPure, Category = "Rarity")
+	FORCEINLINE FLinearColor GetDarkColor() const { return RarityDefinition ? RarityDefinition->Row.DarkColor : FLinearColor::Black; }
+
+	UFUNCTION(BlueprintPure, Category = "Rarity")
+	FORCEINLINE int32 GetNumStars() const { return RarityDefinition ? RarityDefinition->Row.StarsNum : 0; }
+
+	UFUNCTION(BlueprintPure, Category = "Rarity")
+	FORCEINLINE UTexture2D* GetIconBackground() const { return RarityDefinition ? RarityDefinition->Row.IconBackground.Get() : nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "Rarity")
+	TArray<bool> GetActiveStars() const;
 
 	FORCEINLINE int32 GetMaterialIndex() const { return MaterialIndex; }
 	FORCEINLINE void SetMaterialIndex(int32 MatIndex) { MaterialIndex = MatIndex; }
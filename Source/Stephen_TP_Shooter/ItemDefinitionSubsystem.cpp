@@ -0,0 +1,251 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemDefinitionSubsystem.h"
+#include "Stephen_TP_Shooter.h"
+
+#include "Engine/DataTable.h"
+#include "EngineUtils.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "Engine/GameInstance.h"
+
+UItemDefinitionSubsystem::UItemDefinitionSubsystem() :
+	WeaponDataTablePath(FSoftObjectPath(TEXT("/Game/_Game/DataTable/WeaponDataTable.WeaponDataTable"))),
+	WeaponRarityDataTablePath(FSoftObjectPath(TEXT("/Game/_Game/DataTable/WeaponRarityDataTable.WeaponRarityDataTable"))),
+	ItemRarityDataTablePath(FSoftObjectPath(TEXT("/Game/_Game/DataTable/ItemRarityTable.ItemRarityTable"))),
+	bDefinitionsBuilt(false)
+{
+}
+
+static FAutoConsoleCommandWithWorld ItemMemoryReportCommand(
+	TEXT("GunBound.ItemMemoryReport"),
+	TEXT("Logs the measured memory of live items and shared definitions against the per instance copies they replaced"),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&UItemDefinitionSubsystem::LogItemMemoryReport));
+
+void UItemDefinitionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	EnsureDefinitions();
+}
+
+void UItemDefinitionSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	for (UDataTable* DataTable : { WeaponDataTable.Get(), WeaponRarityDataTable.Get(), ItemRarityDataTable.Get() })
+	{
+		if (DataTable)
+			DataTable->OnDataTableChanged().RemoveAll(this);
+	}
+#endif
+
+	Super::Deinitialize();
+}
+
+UItemDefinitionSubsystem* UItemDefinitionSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+
+	return GameInstance ? GameInstance->GetSubsystem<UItemDefinitionSubsystem>() : nullptr;
+}
+
+const FWeaponDataTable* UItemDefinitionSubsystem::FindWeaponRow(EWeaponType WeaponType)
+{
+	const UDataTable* DataTable = GetDefault<UItemDefinitionSubsystem>()->WeaponDataTablePath.LoadSynchronous();
+	return DataTable ? DataTable->FindRow<FWeaponDataTable>(GetWeaponRowName(WeaponType), TEXT("ItemDefinitionSubsystem"), false) : nullptr;
+}
+
+const FItemRarityTable* UItemDefinitionSubsystem::FindRarityRow(EItemRarity Rarity)
+{
+	const UDataTable* DataTable = GetDefault<UItemDefinitionSubsystem>()->ItemRarityDataTablePath.LoadSynchronous();
+	return DataTable ? DataTable->FindRow<FItemRarityTable>(FName(GetRarityRowName(Rarity)), TEXT("ItemDefinitionSubsystem"), false) : nullptr;
+}
+
+const FWeaponDefinition& UItemDefinitionSubsystem::GetWeaponDefinition(EWeaponType WeaponType, EItemRarity Rarity)
+{
+	EnsureDefinitions();
+
+	const int32 TypeIndex = FMath::Min((int32)WeaponType, (int32)EWeaponType::EWT_MAX - 1);
+	const int32 RarityIndex = FMath::Min((int32)Rarity, (int32)EItemRarity::EIR_MAX - 1);
+	return WeaponDefinitions[TypeIndex * (int32)EItemRarity::EIR_MAX + RarityIndex];
+}
+
+const FItemRarityDefinition& UItemDefinitionSubsystem::GetRarityDefinition(EItemRarity Rarity)
+{
+	EnsureDefinitions();
+
+	return RarityDefinitions[FMath::Min((int32)Rarity, (int32)EItemRarity::EIR_MAX - 1)];
+}
+
+void UItemDefinitionSubsystem::EnsureDefinitions()
+{
+	if (bDefinitionsBuilt) return;
+
+	WeaponDataTable = WeaponDataTablePath.LoadSynchronous();
+	WeaponRarityDataTable = WeaponRarityDataTablePath.LoadSynchronous();
+	ItemRarityDataTable = ItemRarityDataTablePath.LoadSynchronous();
+
+#if WITH_EDITOR
+	//Reimporting or editing a table in the editor refreshes the definitions every item points at
+	for (UDataTable* DataTable : { WeaponDataTable.Get(), WeaponRarityDataTable.Get(), ItemRarityDataTable.Get() })
+	{
+		if (DataTable && !DataTable->OnDataTableChanged().IsBoundToObject(this))
+			DataTable->OnDataTableChanged().AddUObject(this, &UItemDefinitionSubsystem::OnDataTableChanged);
+	}
+#endif
+
+	WeaponDefinitions.SetNum((int32)EWeaponType::EWT_MAX * (int32)EItemRarity::EIR_MAX);
+	RarityDefinitions.SetNum((int32)EItemRarity::EIR_MAX);
+
+	bDefinitionsBuilt = true;
+	RebuildDefinitions();
+}
+
+void UItemDefinitionSubsystem::RebuildDefinitions()
+{
+	if (!bDefinitionsBuilt)
+	{
+		EnsureDefinitions();
+		return;
+	}
+
+	static const FString ContextString(TEXT("ItemDefinitionSubsystem"));
+
+	for (uint8 Rarity = 0; Rarity < (uint8)EItemRarity::EIR_MAX; Rarity++)
+	{
+		const FItemRarityTable* RarityRow = ItemRarityDataTable ? ItemRarityDataTable->FindRow<FItemRarityTable>(FName(GetRarityRowName((EItemRarity)Rarity)), ContextString, false) : nullptr;
+		FItemRarityDefinition& Definition = RarityDefinitions[Rarity];
+		Definition.Row = RarityRow ? *RarityRow : FItemRarityTable();
+
+		//Index 0 is unused, Damaged lights one star and every rarity above it one more
+		Definition.ActiveStars.Init(false, 6);
+		for (int32 Star = 1; Star <= Rarity + 1; Star++)
+			Definition.ActiveStars[Star] = true;
+	}
+
+	for (uint8 Type = 0; Type < (uint8)EWeaponType::EWT_MAX; Type++)
+	{
+		const EWeaponType WeaponType = (EWeaponType)Type;
+		const FWeaponDataTable* WeaponRow = WeaponDataTable ? WeaponDataTable->FindRow<FWeaponDataTable>(GetWeaponRowName(WeaponType), ContextString, false) : nullptr;
+		const FString RarityRowPrefix = GetWeaponRarityRowPrefix(WeaponType);
+
+		for (uint8 Rarity = 0; Rarity < (uint8)EItemRarity::EIR_MAX; Rarity++)
+		{
+			const FName RarityRowName(RarityRowPrefix + GetRarityRowName((EItemRarity)Rarity));
+			const FWeaponRarityDataTable* StatsRow = WeaponRarityDataTable ? WeaponRarityDataTable->FindRow<FWeaponRarityDataTable>(RarityRowName, ContextString, false) : nullptr;
+
+			//Assigned in place, items keep pointing at the same entry across rebuilds
+			FWeaponDefinition& Definition = WeaponDefinitions[Type * (int32)EItemRarity::EIR_MAX + Rarity];
+			Definition.WeaponType = WeaponType;
+			Definition.Rarity = (EItemRarity)Rarity;
+			Definition.Data = WeaponRow ? *WeaponRow : FWeaponDataTable();
+			Definition.Stats = StatsRow ? *StatsRow : FWeaponRarityDataTable();
+			Definition.bHasData = WeaponRow != nullptr;
+		}
+	}
+
+	UE_LOG(LogGunBound, Log, TEXT("Built %d weapon and %d rarity definitions"), WeaponDefinitions.Num(), RarityDefinitions.Num());
+}
+
+FName UItemDefinitionSubsystem::GetWeaponRowName(EWeaponType WeaponType)
+{
+	switch (WeaponType)
+	{
+	case EWeaponType::EWT_SubmachineGun:	return FName("SubmachineGun");
+	case EWeaponType::EWT_AssaultRifle:		return FName("AssaultRifle");
+	case EWeaponType::EWT_Pistol:			return FName("Pistol");
+	case EWeaponType::EWT_Shotgun:			return FName("Shotgun");
+	default:								return NAME_None;
+	}
+}
+
+FString UItemDefinitionSubsystem::GetWeaponRarityRowPrefix(EWeaponType WeaponType)
+{
+	switch (WeaponType)
+	{
+	case EWeaponType::EWT_SubmachineGun:	return TEXT("SMG_");
+	case EWeaponType::EWT_AssaultRifle:		return TEXT("AR_");
+	case EWeaponType::EWT_Pistol:			return TEXT("Pistol_");
+	case EWeaponType::EWT_Shotgun:			return TEXT("Shotgun_");
+	default:								return FString();
+	}
+}
+
+FString UItemDefinitionSubsystem::GetRarityRowName(EItemRarity Rarity)
+{
+	switch (Rarity)
+	{
+	case EItemRarity::EIR_Damaged:		return TEXT("Damaged");
+	case EItemRarity::EIR_Common:		return TEXT("Common");
+	case EItemRarity::EIR_Uncommon:		return TEXT("UnCommon");
+	case EItemRarity::EIR_Rare:			return TEXT("Rare");
+	case EItemRarity::EIR_Legendary:	return TEXT("Legendary");
+	default:							return FString();
+	}
+}
+
+#if WITH_EDITOR
+void UItemDefinitionSubsystem::OnDataTableChanged()
+{
+	RebuildDefinitions();
+}
+#endif
+
+void UItemDefinitionSubsystem::LogItemMemoryReport(UWorld* World)
+{
+	if (World == nullptr) return;
+
+	//Fields every item copied from the rarity table before the definitions: glow, light and dark colors, star count, icon background and the star flags
+	const SIZE_T RarityFieldBytes = sizeof(FItemRarityTable::GlowColor) + sizeof(FItemRarityTable::LightColor) + sizeof(FItemRarityTable::DarkColor)
+		+ sizeof(FItemRarityTable::StarsNum) + sizeof(FItemRarityTable::IconBackground) + sizeof(FItemRarityDefinition::ActiveStars);
+
+	//Fields every weapon copied from the weapon tables: fire mode and rate, crosshair spread, muzzle flash, fire sound, hidden bone,
+	//the five crosshairs and the damage, accuracy and recoil stats
+	const SIZE_T WeaponFieldBytes = sizeof(FWeaponDataTable::FireMode) + sizeof(FWeaponDataTable::AutoFireRate) + sizeof(FWeaponDataTable::CrosshairDefaultSpread)
+		+ sizeof(FWeaponDataTable::MuzzleFlash) + sizeof(FWeaponDataTable::FireSound) + sizeof(FWeaponDataTable::BoneToHide)
+		+ 5 * sizeof(FWeaponDataTable::CrosshairMiddle)
+		+ sizeof(FWeaponRarityDataTable::DamageBody) + sizeof(FWeaponRarityDataTable::DamageHeadshot) + sizeof(FWeaponRarityDataTable::DamageMultiplier)
+		+ sizeof(FWeaponRarityDataTable::Accuracy) + sizeof(FWeaponRarityDataTable::RecoilPitch) + sizeof(FWeaponRarityDataTable::RecoilYaw);
+
+	int32 ItemCount = 0;
+	int32 WeaponCount = 0;
+	uint64 ItemBytes = 0;
+	uint64 BaselineBytes = 0;
+
+	//Counted through each item's serialized properties, so the instance size plus everything its arrays and strings allocate
+	for (TActorIterator<AItem> It(World); It; ++It)
+	{
+		AItem* Item = *It;
+		FArchiveCountMem ItemMem(Item);
+
+		ItemCount++;
+		ItemBytes += ItemMem.GetMax();
+
+		//Baseline is the measured item with the removed copies added back and the definition pointer taken away
+		BaselineBytes += ItemMem.GetMax() + RarityFieldBytes + Item->GetActiveStars().GetAllocatedSize() - sizeof(void*);
+
+		if (const AWeapon* Weapon = Cast<AWeapon>(Item))
+		{
+			WeaponCount++;
+
+			//The weapon name string was copied out of the table too
+			BaselineBytes += WeaponFieldBytes - sizeof(void*) + Weapon->GetItemName().GetAllocatedSize();
+		}
+	}
+
+	uint64 SharedBytes = 0;
+	if (UItemDefinitionSubsystem* Subsystem = Get(World))
+	{
+		FArchiveCountMem SubsystemMem(Subsystem);
+		SharedBytes = SubsystemMem.GetMax();
+	}
+
+	UE_LOG(LogGunBound, Log, TEXT("Item memory: %d items (%d weapons)"), ItemCount, WeaponCount);
+	if (ItemCount == 0) return;
+
+	UE_LOG(LogGunBound, Log, TEXT("  Per item now:       %llu bytes"), ItemBytes / ItemCount);
+	UE_LOG(LogGunBound, Log, TEXT("  Per item baseline:  %llu bytes"), BaselineBytes / ItemCount);
+	UE_LOG(LogGunBound, Log, TEXT("  Total now:          %llu bytes + %llu bytes shared definitions"), ItemBytes, SharedBytes);
+	UE_LOG(LogGunBound, Log, TEXT("  Total baseline:     %llu bytes"), BaselineBytes);
+}
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Item.h"
+#include "Weapon.h"
+#include "ItemDefinitionSubsystem.generated.h"
+
+class UDataTable;
+
+/*
+* Loads the weapon, weapon rarity and item rarity data tables once and flattens them into dense
+* [EWeaponType][EItemRarity] and [EItemRarity] arrays of immutable definitions.
+* Items keep a pointer to their definition, so constructing or spawning one is an array index with no row name lookups.
+*/
+UCLASS(Config = Game)
+class STEPHEN_TP_SHOOTER_API UItemDefinitionSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UItemDefinitionSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	//Game instance subsystem of the context world, null in editor worlds which have no game instance
+	static UItemDefinitionSubsystem* Get(const UObject* WorldContextObject);
+
+	//Row lookups straight from the configured tables for editor construction scripts, which have no subsystem.
+	//The rows belong to the table, so callers use them right away instead of keeping them
+	static const FWeaponDataTable* FindWeaponRow(EWeaponType WeaponType);
+	static const FItemRarityTable* FindRarityRow(EItemRarity Rarity);
+
+	const FWeaponDefinition& GetWeaponDefinition(EWeaponType WeaponType, EItemRarity Rarity);
+	const FItemRarityDefinition& GetRarityDefinition(EItemRarity Rarity);
+
+	//Reloads every definition in place, pointers held by items stay valid
+	void RebuildDefinitions();
+
+	//Logs the measured memory of every live item and of the shared definitions, next to the baseline with per instance copies
+	static void LogItemMemoryReport(UWorld* World);
+
+private:
+	void EnsureDefinitions();
+
+	static FName GetWeaponRowName(EWeaponType WeaponType);
+	static FString GetWeaponRarityRowPrefix(EWeaponType WeaponType);
+	static FString GetRarityRowName(EItemRarity Rarity);
+
+#if WITH_EDITOR
+	void OnDataTableChanged();
+#endif
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> WeaponDataTablePath;
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> WeaponRarityDataTablePath;
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> ItemRarityDataTablePath;
+
+	UPROPERTY()
+	TObjectPtr<UDataTable> WeaponDataTable;
+
+	UPROPERTY()
+	TObjectPtr<UDataTable> WeaponRarityDataTable;
+
+	UPROPERTY()
+	TObjectPtr<UDataTable> ItemRarityDataTable;
+
+	//EWT_MAX * EIR_MAX entries indexed by WeaponType * EIR_MAX + Rarity, sized once so entries never move
+	UPROPERTY()
+	TArray<FWeaponDefinition> WeaponDefinitions;
+
+	//EIR_MAX entries indexed by Rarity
+	UPROPERTY()
+	TArray<FItemRarityDefinition> RarityDefinitions;
+
+	bool bDefinitionsBuilt;
+};
@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemPulseSubsystem.h"
+#include "Stephen_TP_Shooter.h"
+#include "Item.h"
+
+#include "Curves/CurveVector.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+
+DECLARE_CYCLE_STAT(TEXT("Item Pulse Tick"), STAT_ItemPulseTick, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pulse Curve Evaluations"), STAT_ItemPulseCurveEvaluations, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pulse Material Updates"), STAT_ItemPulseMaterialUpdates, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pulse Shared Items"), STAT_ItemPulseSharedItems, STATGROUP_GunBound);
+
+UItemPulseSubsystem::UItemPulseSubsystem() :
+	SharedPulseCurve(FSoftObjectPath(TEXT("/Game/_Game/Curves/MaterialPulseCurve.MaterialPulseCurve"))),
+	PulsePeriod(5.0f),
+	SharedPulseScale(FVector(150.0f, 3.0f, 4.0f)),
+	NumRegisteredItems(0)
+{
+}
+
+void UItemPulseSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (PulseParameterCollection.IsNull()) return;
+
+	UMaterialParameterCollection* ParameterCollection = PulseParameterCollection.LoadSynchronous();
+	LoadedSharedPulseCurve = SharedPulseCurve.LoadSynchronous();
+
+	if (ParameterCollection == nullptr || LoadedSharedPulseCurve == nullptr)
+	{
+		UE_LOG(LogGunBound, Warning, TEXT("ItemPulseSubsystem: PulseParameterCollection or SharedPulseCurve failed to load, pulsing every item through its own material"));
+		LoadedSharedPulseCurve = nullptr;
+		return;
+	}
+
+	PulseCollectionInstance = GetWorld()->GetParameterCollectionInstance(ParameterCollection);
+}
+
+void UItemPulseSubsystem::Deinitialize()
+{
+	SharedItems.Empty();
+	PulseGroups.Empty();
+	NumRegisteredItems = 0;
+
+	PulseCollectionInstance = nullptr;
+	LoadedSharedPulseCurve = nullptr;
+
+	Super::Deinitialize();
+}
+
+TStatId UItemPulseSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemPulseSubsystem, STATGROUP_Tickables);
+}
+
+UItemPulseSubsystem* UItemPulseSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (WorldContextObject == nullptr) return nullptr;
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UItemPulseSubsystem>() : nullptr;
+}
+
+bool UItemPulseSubsystem::UsesSharedPulse(const AItem* Item) const
+{
+	return PulseCollectionInstance && Item->GetPulseCurve() == LoadedSharedPulseCurve;
+}
+
+void UItemPulseSubsystem::RegisterItem(AItem* Item)
+{
+	if (Item == nullptr || Item->GetPulseCurve() == nullptr) return;
+
+	if (UsesSharedPulse(Item))
+	{
+		if (SharedItems.Contains(Item)) return;
+
+		SharedItems.Add(Item);
+		Item->SetSharedPulse(true);
+	}
+	else
+	{
+		TArray<TWeakObjectPtr<AItem>>& Group = PulseGroups.FindOrAdd(Item->GetPulseCurve());
+		if (Group.Contains(Item)) return;
+
+		Group.Add(Item);
+	}
+
+	NumRegisteredItems++;
+}
+
+void UItemPulseSubsystem::UnregisterItem(AItem* Item)
+{
+	if (Item == nullptr) return;
+
+	bool bRemoved = SharedItems.RemoveSingleSwap(Item, false) > 0;
+
+	if (!bRemoved && Item->GetPulseCurve())
+	{
+		if (TArray<TWeakObjectPtr<AItem>>* Group = PulseGroups.Find(Item->GetPulseCurve()))
+			bRemoved = Group->RemoveSingleSwap(Item, false) > 0;
+	}
+
+	if (!bRemoved) return;
+
+	NumRegisteredItems--;
+
+	Item->SetSharedPulse(false);
+	Item->ApplyPulse(FVector::ZeroVector);
+}
+
+void UItemPulseSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ItemPulseTick);
+
+	if (NumRegisteredItems == 0) return;
+
+	const double CurveTime = FMath::Fmod(GetWorld()->GetTimeSeconds(), (double)FMath::Max(PulsePeriod, KINDA_SMALL_NUMBER));
+
+	if (PulseCollectionInstance && SharedItems.Num() > 0)
+	{
+		const FVector CurveVal = LoadedSharedPulseCurve->GetVectorValue(CurveTime) * SharedPulseScale;
+		INC_DWORD_STAT(STAT_ItemPulseCurveEvaluations);
+
+		PulseCollectionInstance->SetScalarParameterValue(TEXT("GlowAmount"), CurveVal.X);
+		PulseCollectionInstance->SetScalarParameterValue(TEXT("FresnelExponent"), CurveVal.Y);
+		PulseCollectionInstance->SetScalarParameterValue(TEXT("FresnelReflectFraction"), CurveVal.Z);
+
+		SET_DWORD_STAT(STAT_ItemPulseSharedItems, SharedItems.Num());
+	}
+
+	for (auto It = PulseGroups.CreateIterator(); It; ++It)
+	{
+		TArray<TWeakObjectPtr<AItem>>& Group = It.Value();
+
+		//Destroyed items are removed here instead of on EndPlay of every subclass
+		for (int32 i = Group.Num() - 1; i >= 0; i--)
+		{
+			if (Group[i].IsValid()) continue;
+
+			Group.RemoveAtSwap(i, 1, false);
+			NumRegisteredItems--;
+		}
+
+		if (Group.Num() == 0)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const FVector CurveVal = It.Key()->GetVectorValue(CurveTime);
+		INC_DWORD_STAT(STAT_ItemPulseCurveEvaluations);
+
+		for (const TWeakObjectPtr<AItem>& Item : Group)
+			Item->ApplyPulse(CurveVal);
+
+		INC_DWORD_STAT_BY(STAT_ItemPulseMaterialUpdates, Group.Num());
+	}
+
+	for (int32 i = SharedItems.Num() - 1; i >= 0; i--)
+	{
+		if (SharedItems[i].IsValid()) continue;
+
+		SharedItems.RemoveAtSwap(i, 1, false);
+		NumRegisteredItems--;
+	}
+}
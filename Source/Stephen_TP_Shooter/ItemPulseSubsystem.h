@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemPulseSubsystem.generated.h"
+
+class AItem;
+class UCurveVector;
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
+
+/*
+* Drives the glow pulse of every idle pickup from one place.
+* Each pulse curve is evaluated once per frame on the same PulsePeriod. Items on SharedPulseCurve read it from
+* PulseParameterCollection (the item master material switches to it on SharedPulseAlpha), every other item gets
+* the value pushed into its dynamic material.
+* Items in a special state (Equip Interping) keep driving their own parameters.
+*/
+UCLASS(Config = Game)
+class STEPHEN_TP_SHOOTER_API UItemPulseSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UItemPulseSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static UItemPulseSubsystem* Get(const UObject* WorldContextObject);
+
+	//Starts pulsing the Item with the other idle pickups
+	void RegisterItem(AItem* Item);
+
+	//Stops pulsing the Item and clears its pulse parameters
+	void UnregisterItem(AItem* Item);
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetRegisteredItemCount() const { return NumRegisteredItems; }
+
+private:
+	bool UsesSharedPulse(const AItem* Item) const;
+
+	//Material Parameter Collection read by the item materials, empty to push the pulse into each item instead
+	UPROPERTY(Config)
+	TSoftObjectPtr<UMaterialParameterCollection> PulseParameterCollection;
+
+	//Curve written into PulseParameterCollection
+	UPROPERTY(Config)
+	TSoftObjectPtr<UCurveVector> SharedPulseCurve;
+
+	//Seconds for one loop of every pulse curve, so all idle pickups pulse in step
+	UPROPERTY(Config)
+	float PulsePeriod;
+
+	//Scales applied to the X, Y and Z axis of SharedPulseCurve before writing them into the collection
+	UPROPERTY(Config)
+	FVector SharedPulseScale;
+
+	UPROPERTY()
+	TObjectPtr<UMaterialParameterCollectionInstance> PulseCollectionInstance;
+
+	UPROPERTY()
+	TObjectPtr<UCurveVector> LoadedSharedPulseCurve;
+
+	//Items reading their pulse from PulseCollectionInstance
+	TArray<TWeakObjectPtr<AItem>> SharedItems;
+
+	//Items whose dynamic material is updated every frame, grouped by curve
+	TMap<const UCurveVector*, TArray<TWeakObjectPtr<AItem>>> PulseGroups;
+
+	int32 NumRegisteredItems;
+};
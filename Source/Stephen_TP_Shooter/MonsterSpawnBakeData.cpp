@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MonsterSpawnBakeData.h"
+
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+UMonsterSpawnBakeData::UMonsterSpawnBakeData() :
+	MaxVisibilityRatio(0.6f),
+	MinReachableRatio(0.5f),
+	SampleCount(0)
+{
+}
+
+void UMonsterSpawnBakeData::PostLoad()
+{
+	Super::PostLoad();
+
+	RebuildLookup();
+}
+
+void UMonsterSpawnBakeData::RebuildLookup()
+{
+	EntryLookup.Reset();
+
+	for (int32 i = 0; i < SpawnPoints.Num(); i++)
+		EntryLookup.Add(SpawnPoints[i].SpawnPointName, i);
+}
+
+const FMonsterSpawnPointBakeEntry* UMonsterSpawnBakeData::FindEntry(FName SpawnPointName) const
+{
+	const int32* Index = EntryLookup.Find(SpawnPointName);
+	return Index ? &SpawnPoints[*Index] : nullptr;
+}
+
+bool UMonsterSpawnBakeData::IsSpawnPointUsable(FName SpawnPointName) const
+{
+	const FMonsterSpawnPointBakeEntry* Entry = FindEntry(SpawnPointName);
+	if (Entry == nullptr) return true;
+
+	return Entry->bOnNavMesh && Entry->ReachableRatio >= MinReachableRatio && Entry->VisibilityRatio <= MaxVisibilityRatio;
+}
+
+FString UMonsterSpawnBakeData::GetPackageNameForMap(const FString& MapPackageName)
+{
+	//Bakes live in one folder that is always cooked, nothing else references them
+	return FString(BakeDirectory) / FPackageName::GetShortName(MapPackageName) + TEXT("_SpawnBake");
+}
+
+UMonsterSpawnBakeData* UMonsterSpawnBakeData::LoadForWorld(const UWorld* World)
+{
+	if (World == nullptr) return nullptr;
+
+	const FString MapPackageName = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+	const FString PackageName = GetPackageNameForMap(MapPackageName);
+	if (!FPackageName::DoesPackageExist(PackageName)) return nullptr;
+
+	const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+	return LoadObject<UMonsterSpawnBakeData>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn | LOAD_Quiet);
+}
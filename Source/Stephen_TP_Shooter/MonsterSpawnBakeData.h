@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "MonsterSpawnBakeData.generated.h"
+
+class UWorld;
+
+USTRUCT(BlueprintType)
+struct FMonsterSpawnPointBakeEntry
+{
+	GENERATED_BODY()
+
+	//Actor name of the Monster Spawn Point in the map
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FName SpawnPointName;
+
+	//Fraction of sampled player positions that had a clear line of sight to this spawn point
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float VisibilityRatio;
+
+	//Fraction of sampled player positions reachable over the navmesh from this spawn point
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float ReachableRatio;
+
+	//False when the spawn point couldn't be projected on the navmesh at all
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	bool bOnNavMesh;
+
+	FMonsterSpawnPointBakeEntry()
+	{
+		VisibilityRatio = 0.0f;
+		ReachableRatio = 0.0f;
+		bOnNavMesh = false;
+	}
+};
+
+/*
+* Per map spawn point visibility and reachability, baked offline by the BakeMonsterSpawnPoints commandlet.
+* Saved to BakeDirectory as <MapName>_SpawnBake (always cooked) and looked up by the Game State at match start.
+*/
+UCLASS(BlueprintType)
+class STEPHEN_TP_SHOOTER_API UMonsterSpawnBakeData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UMonsterSpawnBakeData();
+
+	virtual void PostLoad() override;
+
+	//Spawn points seen by more sampled positions than this are rejected
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawn Bake", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MaxVisibilityRatio;
+
+	//Spawn points reaching fewer sampled positions than this are rejected
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawn Bake", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinReachableRatio;
+
+	//Number of player positions sampled across the navmesh for this bake
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn Bake")
+	int32 SampleCount;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn Bake")
+	TArray<FMonsterSpawnPointBakeEntry> SpawnPoints;
+
+	//Rebuilds the name lookup after SpawnPoints changed
+	void RebuildLookup();
+
+	const FMonsterSpawnPointBakeEntry* FindEntry(FName SpawnPointName) const;
+
+	//Table lookup only, spawn points missing from the bake are treated as usable
+	bool IsSpawnPointUsable(FName SpawnPointName) const;
+
+	static FString GetPackageNameForMap(const FString& MapPackageName);
+
+	//Content folder holding every bake, listed in DirectoriesToAlwaysCook
+	static constexpr const TCHAR* BakeDirectory = TEXT("/Game/_Game/SpawnBakes");
+	static UMonsterSpawnBakeData* LoadForWorld(const UWorld* World);
+
+private:
+	TMap<FName, int32> EntryLookup;
+};
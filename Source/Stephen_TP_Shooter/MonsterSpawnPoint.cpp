@@ -32,14 +32,46 @@ void AMonsterSpawnPoint::BeginPlay()
 	Super::BeginPlay();
 
 	ShooterGameState = Cast<AShooterGameState>(UGameplayStatics::GetGameState(GetWorld()));
+
+	OverlapSphereComp->OnComponentBeginOverlap.AddDynamic(this, &AMonsterSpawnPoint::OnOverlapSphereBegin);
+	OverlapSphereComp->OnComponentEndOverlap.AddDynamic(this, &AMonsterSpawnPoint::OnOverlapSphereEnd);
+
+	//Pick up anything that was already standing here before the events were bound
+	TArray<UPrimitiveComponent*> OverlappingComponents;
+	OverlapSphereComp->GetOverlappingComponents(OverlappingComponents);
+	for (UPrimitiveComponent* OverlappingComp : OverlappingComponents)
+	{
+		if (OverlappingComp && IsOccupantComponent(OverlappingComp->GetOwner(), OverlappingComp))
+			Occupants.Add(OverlappingComp->GetOwner());
+	}
+}
+
+void AMonsterSpawnPoint::OnOverlapSphereBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (!IsOccupantComponent(OtherActor, OtherComp)) return;
+
+	Occupants.Add(OtherActor);
 }
 
-bool AMonsterSpawnPoint::IsOccupied()
+void AMonsterSpawnPoint::OnOverlapSphereEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
-	TArray<AActor*> OverlapArray;
-	GetOverlappingActors(OverlapArray, ACharacter::StaticClass());
+	if (!IsOccupantComponent(OtherActor, OtherComp)) return;
 
-	return OverlapArray.Num() > 0;
+	Occupants.Remove(OtherActor);
+}
+
+bool AMonsterSpawnPoint::IsOccupantComponent(AActor* OtherActor, UPrimitiveComponent* OtherComp) const
+{
+	//Only the capsule counts, so ragdoll meshes and combat spheres don't keep a point occupied
+	auto Character = Cast<ACharacter>(OtherActor);
+	return Character && OtherComp == Character->GetCapsuleComponent();
+}
+
+void AMonsterSpawnPoint::AddOccupant(AActor* Occupant)
+{
+	if (Occupant == nullptr) return;
+
+	Occupants.Add(Occupant);
 }
 
 bool AMonsterSpawnPoint::IsVisibleToPlayer()
@@ -48,11 +80,8 @@ bool AMonsterSpawnPoint::IsVisibleToPlayer()
 
 	auto& ShooterCharacter = *ShooterGameState->GetShooterCharacter();
 
-	FVector StartTrace = GetActorLocation();
-	FVector EndTrace = ShooterCharacter.GetActorLocation();
-	EndTrace.Z += ShooterCharacter.GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 0.75f;
-
-	FVector EndDir = (EndTrace - GetActorLocation()).GetUnsafeNormal();
+	FVector StartTrace, EndTrace;
+	GetVisibilityTrace(ShooterCharacter, StartTrace, EndTrace);
 	
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(this);
@@ -60,7 +89,20 @@ bool AMonsterSpawnPoint::IsVisibleToPlayer()
 	FHitResult HitResult;
 	bool bBlockHit = GetWorld()->LineTraceSingleByChannel(HitResult, StartTrace, EndTrace, ECollisionChannel::ECC_Pawn, QueryParams);
 	
-	float Dot = FVector::DotProduct(ShooterCharacter.GetActorForwardVector(), EndDir);
-	
-	return (bBlockHit && HitResult.GetActor() == ShooterGameState->GetShooterCharacter() && Dot < 0.0f);
+	return (bBlockHit && HitResult.GetActor() == ShooterGameState->GetShooterCharacter() && IsFacedByPlayer(ShooterCharacter, EndTrace));
 }
+
+void AMonsterSpawnPoint::GetVisibilityTrace(const AShooterCharacter& ShooterCharacter, FVector& OutStart, FVector& OutEnd) const
+{
+	OutStart = GetActorLocation();
+	OutEnd = ShooterCharacter.GetActorLocation();
+	OutEnd.Z += ShooterCharacter.GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 0.75f;
+}
+
+bool AMonsterSpawnPoint::IsFacedByPlayer(const AShooterCharacter& ShooterCharacter, const FVector& TraceEnd) const
+{
+	FVector EndDir = (TraceEnd - GetActorLocation()).GetUnsafeNormal();
+
+	float Dot = FVector::DotProduct(ShooterCharacter.GetActorForwardVector(), EndDir);
+	return Dot < 0.0f;
+}
\ No newline at end of file
@@ -35,14 +35,38 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UArrowComponent> ArrowComp;
 
+	//Characters whose capsule is inside OverlapSphereComp, kept up to date by overlap events
+	TSet<TObjectKey<AActor>> Occupants;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	UFUNCTION()
+	void OnOverlapSphereBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	UFUNCTION()
+	void OnOverlapSphereEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	bool IsOccupantComponent(AActor* OtherActor, UPrimitiveComponent* OtherComp) const;
+
 public:
 	UFUNCTION(BlueprintCallable)
-	bool IsOccupied();
+	FORCEINLINE bool IsOccupied() const { return Occupants.Num() > 0; }
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetOccupantCount() const { return Occupants.Num(); }
+
+	//Marks a character as occupying this point right away, used when a pooled enemy is teleported in
+	//before its overlap events have been processed
+	void AddOccupant(AActor* Occupant);
 
 	UFUNCTION(BlueprintCallable)
 	bool IsVisibleToPlayer();
+
+	//Segment used for the visibility check, from this spawn point to the Player's upper body
+	void GetVisibilityTrace(const AShooterCharacter& ShooterCharacter, FVector& OutStart, FVector& OutEnd) const;
+
+	//True when the Player is facing toward this spawn point
+	bool IsFacedByPlayer(const AShooterCharacter& ShooterCharacter, const FVector& TraceEnd) const;
 };
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RandomStreamSubsystem.h"
+#include "Stephen_TP_Shooter.h"
+
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+
+const FName URandomStreamSubsystem::SpawnStream(TEXT("Spawn"));
+const FName URandomStreamSubsystem::WeaponStream(TEXT("Weapon"));
+const FName URandomStreamSubsystem::AIStream(TEXT("AI"));
+const FName URandomStreamSubsystem::CombatStream(TEXT("Combat"));
+
+void URandomStreamSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	int32 Seed = 0;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("GameplaySeed="), Seed))
+		Seed = (int32)(FPlatformTime::Cycles() & MAX_int32);
+
+	ResetStreams(Seed);
+}
+
+void URandomStreamSubsystem::ResetStreams(int32 NewSeed)
+{
+	MasterSeed = NewSeed;
+
+	for (auto& StreamPair : Streams)
+		StreamPair.Value.Initialize(GetStreamSeed(StreamPair.Key));
+
+	UE_LOG(LogGunBound, Log, TEXT("Gameplay random streams seeded with %d"), MasterSeed);
+}
+
+FRandomStream& URandomStreamSubsystem::GetStream(FName StreamName)
+{
+	if (FRandomStream* Stream = Streams.Find(StreamName))
+		return *Stream;
+
+	return Streams.Add(StreamName, FRandomStream(GetStreamSeed(StreamName)));
+}
+
+FRandomStream& URandomStreamSubsystem::GetStream(const UObject* WorldContextObject, FName StreamName)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (URandomStreamSubsystem* RandomStreams = World ? World->GetSubsystem<URandomStreamSubsystem>() : nullptr)
+		return RandomStreams->GetStream(StreamName);
+
+	static FRandomStream UnseededStream((int32)(FPlatformTime::Cycles() & MAX_int32));
+	return UnseededStream;
+}
+
+int32 URandomStreamSubsystem::GetStreamSeed(FName StreamName) const
+{
+	//Crc of the string rather than the FName hash, which depends on name table order
+	return (int32)HashCombine((uint32)MasterSeed, FCrc::StrCrc32(*StreamName.ToString()));
+}
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RandomStreamSubsystem.generated.h"
+
+/*
+* Hands out named random streams, all derived from one master seed.
+* Launch with -GameplaySeed=<int> to replay a match with the same spawn, spread and AI rolls.
+*/
+UCLASS()
+class STEPHEN_TP_SHOOTER_API URandomStreamSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	//Monster type and spawn point picks
+	static const FName SpawnStream;
+
+	//Bullet spread, recoil and weapon throws
+	static const FName WeaponStream;
+
+	//Enemy decisions (attack sections, greetings, hit react times)
+	static const FName AIStream;
+
+	//Stun rolls for both the player and enemies
+	static const FName CombatStream;
+
+	//Reseeds every stream from NewSeed
+	UFUNCTION(BlueprintCallable)
+	void ResetStreams(int32 NewSeed);
+
+	FRandomStream& GetStream(FName StreamName);
+
+	//Stream from the context object's world, falls back to an unseeded stream outside of a game world
+	static FRandomStream& GetStream(const UObject* WorldContextObject, FName StreamName);
+
+private:
+	int32 GetStreamSeed(FName StreamName) const;
+
+	int32 MasterSeed;
+
+	TMap<FName, FRandomStream> Streams;
+
+public:
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE int32 GetMasterSeed() const { return MasterSeed; }
+};
@@ -36,83 +36,110 @@ UShooterAnimInstance::UShooterAnimInstance() :
 
 void UShooterAnimInstance::UpdateAnimationProperties(float DeltaTime)
 {
-	if(ShooterCharacter == nullptr)
+}
+
+void UShooterAnimInstance::NativeInitializeAnimation()
+{
+	Super::NativeInitializeAnimation();
+
+	ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
+}
+
+void UShooterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeUpdateAnimation(DeltaSeconds);
+
+	if (ShooterCharacter == nullptr)
 		ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
 
-	if (ShooterCharacter)
-	{
-		if (ShooterCharacter->GetHealthComponent() && ShooterCharacter->GetHealthComponent()->IsDead()) return;
+	//Dead characters keep their last pose properties
+	Snapshot.bValid = ShooterCharacter && !(ShooterCharacter->GetHealthComponent() && ShooterCharacter->GetHealthComponent()->IsDead());
+	if (!Snapshot.bValid) return;
+
+	Snapshot.Velocity = ShooterCharacter->GetVelocity();
+	Snapshot.bIsFalling = ShooterCharacter->GetCharacterMovement()->IsFalling();
+	Snapshot.bIsAccelerating = ShooterCharacter->GetCharacterMovement()->GetCurrentAcceleration().Size() > 0.f;
+	Snapshot.BaseAimRotation = ShooterCharacter->GetBaseAimRotation();
+	Snapshot.ActorRotation = ShooterCharacter->GetActorRotation();
+
+	const ECombatState CombatState = ShooterCharacter->GetCombateState();
+	Snapshot.bAiming = ShooterCharacter->GetAimingStatus();
+	Snapshot.bCrouching = ShooterCharacter->GetCrouchingStatus();
+	Snapshot.bReloading = CombatState == ECombatState::ECS_Reloading;
+	Snapshot.bEquipping = CombatState == ECombatState::ECS_Equipping;
+	Snapshot.bThrowingGrenade = CombatState == ECombatState::ECS_Throwing;
+	Snapshot.bPickingUp = CombatState == ECombatState::ECS_PickingUp;
+	Snapshot.bShouldUseFABRIK = CombatState == ECombatState::ECS_Unoccupied || CombatState == ECombatState::ECS_FireTimerInProgress;
+
+	const AWeapon* EquippedWeapon = ShooterCharacter->GetInventoryComponent()->GetEquippedWeapon();
+	Snapshot.bHasEquippedWeapon = EquippedWeapon != nullptr;
+	if (EquippedWeapon)
+		Snapshot.EquippedWeaponType = EquippedWeapon->GetWeaponType();
+
+	Snapshot.TurningCurve = GetCurveValue(TEXT("Turning"));
+	Snapshot.RotationCurve = GetCurveValue(TEXT("Rotation"));
+}
+
+void UShooterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
 
-		bCrouching = ShooterCharacter->GetCrouchingStatus();
-		bReloading = ShooterCharacter->GetCombateState() == ECombatState::ECS_Reloading;
-		bEquipping = ShooterCharacter->GetCombateState() == ECombatState::ECS_Equipping;
-		bThrowingGrenade = ShooterCharacter->GetCombateState() == ECombatState::ECS_Throwing;
-		bPickingUp = ShooterCharacter->GetCombateState() == ECombatState::ECS_PickingUp;
-		bShouldUseFABRIK = ShooterCharacter->GetCombateState() == ECombatState::ECS_Unoccupied || ShooterCharacter->GetCombateState() == ECombatState::ECS_FireTimerInProgress;
+	if (!Snapshot.bValid) return;
 
-		//Get lateral speed of character from velocity
-		FVector Velocity{ ShooterCharacter->GetVelocity() };
-		Velocity.Z = 0;
-		Speed = Velocity.Size();
+	bCrouching = Snapshot.bCrouching;
+	bReloading = Snapshot.bReloading;
+	bEquipping = Snapshot.bEquipping;
+	bThrowingGrenade = Snapshot.bThrowingGrenade;
+	bPickingUp = Snapshot.bPickingUp;
+	bShouldUseFABRIK = Snapshot.bShouldUseFABRIK;
 
-		//Is in Air?
-		bIsInAir = ShooterCharacter->GetCharacterMovement()->IsFalling();
+	//Get lateral speed of character from velocity
+	FVector Velocity{ Snapshot.Velocity };
+	Velocity.Z = 0;
+	Speed = Velocity.Size();
 
-		//Is Character accel?
-		bIsAccelerating = (ShooterCharacter->GetCharacterMovement()->GetCurrentAcceleration().Size() > 0.f);
+	//Is in Air?
+	bIsInAir = Snapshot.bIsFalling;
 
-		//Strafing Calculation for Blendspace
-		FRotator AimRotation = ShooterCharacter->GetBaseAimRotation();
-		FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(ShooterCharacter->GetVelocity());
+	//Is Character accel?
+	bIsAccelerating = Snapshot.bIsAccelerating;
 
-		MovementOffsetYaw = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation, AimRotation).Yaw;
+	//Strafing Calculation for Blendspace
+	FRotator AimRotation = Snapshot.BaseAimRotation;
+	FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(Snapshot.Velocity);
 
-		if(ShooterCharacter->GetVelocity().Size() > 0.0f)
-			LastMovementOffsetYaw = MovementOffsetYaw;
+	MovementOffsetYaw = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation, AimRotation).Yaw;
 
-		bAiming = ShooterCharacter->GetAimingStatus();		
+	if (Snapshot.Velocity.Size() > 0.0f)
+		LastMovementOffsetYaw = MovementOffsetYaw;
 
-		if (bReloading)
-			OffsetState = EOffsetState::EOS_Reloading;
-		else if (bIsInAir)
-			OffsetState = EOffsetState::EOS_InAir;
-		else if (ShooterCharacter->GetAimingStatus())
-			OffsetState = EOffsetState::EOS_Aiming;
-		else
-			OffsetState = EOffsetState::EOS_Hip;
+	bAiming = Snapshot.bAiming;
 
-		/*FString RotationMessage = FString::Printf(TEXT("Base Aim Rotation: %f"), AimRotation.Yaw);
-		FString MovementRotationMessage = FString::Printf(TEXT("Movement Rotation: %f"), MovementRotation.Yaw);
-		if (GEngine)
-		{
-			GEngine->AddOnScreenDebugMessage(1, 0.0f, FColor::White, RotationMessage);
-			GEngine->AddOnScreenDebugMessage(1, 0.0f, FColor::White, MovementRotationMessage);
-		}*/
+	if (bReloading)
+		OffsetState = EOffsetState::EOS_Reloading;
+	else if (bIsInAir)
+		OffsetState = EOffsetState::EOS_InAir;
+	else if (bAiming)
+		OffsetState = EOffsetState::EOS_Aiming;
+	else
+		OffsetState = EOffsetState::EOS_Hip;
 
-		//Check if Shooter Character has valid equipped weapon
-		if (ShooterCharacter->GetInventoryComponent()->GetEquippedWeapon())
-			EquippedWeaponType = ShooterCharacter->GetInventoryComponent()->GetEquippedWeapon()->GetWeaponType();
-		
-		TurnInPlace();
-		Lean(DeltaTime);
-	}
-}
+	//Check if Shooter Character has valid equipped weapon
+	if (Snapshot.bHasEquippedWeapon)
+		EquippedWeaponType = Snapshot.EquippedWeaponType;
 
-void UShooterAnimInstance::NativeInitializeAnimation()
-{
-	ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
+	TurnInPlace();
+	Lean(DeltaSeconds);
 }
 
 void UShooterAnimInstance::TurnInPlace()
 {
-	if (ShooterCharacter == nullptr) return;
-
-	Pitch = ShooterCharacter->GetBaseAimRotation().Pitch;
+	Pitch = Snapshot.BaseAimRotation.Pitch;
 	if (Speed > 0 || bIsInAir)
 	{
 		//Don't want Turning Place Anim when moving
 		RootYawOffset = 0.0f;
-		TIPCharacterYaw = ShooterCharacter->GetActorRotation().Yaw;
+		TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
 		TIPCharacterYawLastFrame = TIPCharacterYaw;
 
 		RotationCurveLastFrame = 0.0f;
@@ -121,7 +148,7 @@ void UShooterAnimInstance::TurnInPlace()
 	else
 	{
 		TIPCharacterYawLastFrame = TIPCharacterYaw;
-		TIPCharacterYaw = ShooterCharacter->GetActorRotation().Yaw;
+		TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
 
 		const float TIPYawDelta{ TIPCharacterYaw - TIPCharacterYawLastFrame };
 		
@@ -129,12 +156,12 @@ void UShooterAnimInstance::TurnInPlace()
 		RootYawOffset = UKismetMathLibrary::NormalizeAxis(RootYawOffset - TIPYawDelta);
 
 		//1.0 if Turning, 0.0 if not
-		const float Turning{ GetCurveValue(TEXT("Turning")) };
+		const float Turning{ Snapshot.TurningCurve };
 		if (Turning > 0)
 		{
 			bTurningInPlace = true;
 			RotationCurveLastFrame = RotationCurve;
-			RotationCurve = GetCurveValue(TEXT("Rotation"));
+			RotationCurve = Snapshot.RotationCurve;
 			const float DeltaRotation{ RotationCurve - RotationCurveLastFrame };
 
 			//If RootYawOffset > 0? We are turning Left
@@ -188,10 +215,8 @@ void UShooterAnimInstance::TurnInPlace()
 
 void UShooterAnimInstance::Lean(float DeltaTime)
 {
-	if (ShooterCharacter == nullptr) return;
-
 	CharacterRotationLastFrame = CharacterRotation;
-	CharacterRotation = ShooterCharacter->GetActorRotation();
+	CharacterRotation = Snapshot.ActorRotation;
 
 	const FRotator Delta{ UKismetMathLibrary::NormalizedDeltaRotator(CharacterRotation, CharacterRotationLastFrame) };
 
@@ -20,6 +20,54 @@ enum class EOffsetState : uint8
 	EOS_MAX UMETA(DisplayName = "Default Max"),
 };
 
+//Character state copied on the game thread, read by the thread safe animation update
+struct FShooterAnimSnapshot
+{
+	bool bValid;
+
+	FVector Velocity;
+	bool bIsFalling;
+	bool bIsAccelerating;
+	FRotator BaseAimRotation;
+	FRotator ActorRotation;
+
+	bool bAiming;
+	bool bCrouching;
+	bool bReloading;
+	bool bEquipping;
+	bool bThrowingGrenade;
+	bool bPickingUp;
+	bool bShouldUseFABRIK;
+
+	bool bHasEquippedWeapon;
+	EWeaponType EquippedWeaponType;
+
+	//Curves of the previous pose, read on the game thread
+	float TurningCurve;
+	float RotationCurve;
+
+	FShooterAnimSnapshot()
+	{
+		bValid = false;
+		Velocity = FVector::ZeroVector;
+		bIsFalling = false;
+		bIsAccelerating = false;
+		BaseAimRotation = FRotator::ZeroRotator;
+		ActorRotation = FRotator::ZeroRotator;
+		bAiming = false;
+		bCrouching = false;
+		bReloading = false;
+		bEquipping = false;
+		bThrowingGrenade = false;
+		bPickingUp = false;
+		bShouldUseFABRIK = false;
+		bHasEquippedWeapon = false;
+		EquippedWeaponType = EWeaponType::EWT_MAX;
+		TurningCurve = 0.0f;
+		RotationCurve = 0.0f;
+	}
+};
+
 /**
  * 
  */
@@ -31,10 +79,13 @@ class STEPHEN_TP_SHOOTER_API UShooterAnimInstance : public UAnimInstance
 public:
 	UShooterAnimInstance();
 
-	UFUNCTION(BlueprintCallable)
+	//Kept so existing Blueprint graphs still compile, properties are now updated natively
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Properties are updated in NativeThreadSafeUpdateAnimation, remove this call from the Event Graph."))
 	void UpdateAnimationProperties(float DeltaTime);
 
 	virtual void NativeInitializeAnimation() override;
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 
 protected:
 	//Handle Turning in place variables
@@ -135,4 +186,6 @@ private:
 	//True when not reloading and equipped
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	bool bShouldUseFABRIK;
+
+	FShooterAnimSnapshot Snapshot;
 };
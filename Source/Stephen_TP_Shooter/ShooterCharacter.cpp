@@ -13,15 +13,16 @@
 #include "InventoryComponent.h"
 #include "SoundsDataAsset.h"
 #include "BulletHitInterface.h"
+#include "RandomStreamSubsystem.h"
+#include "AudioVoiceSubsystem.h"
+#include "FXPoolSubsystem.h"
 #include "Stephen_TP_Shooter.h"
 
 #include "Components/BoxComponent.h"
 #include "Components/SphereComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/WidgetComponent.h"
-#include "Components/AudioComponent.h"
 
-#include "BehaviorTree/BlackboardComponent.h"
 
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -36,6 +37,9 @@
 #include "Particles/ParticleSystemComponent.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 
+DECLARE_CYCLE_STAT(TEXT("Trace For Items"), STAT_TraceForItems, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Traces Issued"), STAT_ItemTracesIssued, STATGROUP_GunBound);
+
 // Sets default values
 AShooterCharacter::AShooterCharacter() :
 	PickupSoundResetTime(0.2f),
@@ -64,6 +68,13 @@ AShooterCharacter::AShooterCharacter() :
 
 	//Item Variables
 	bShouldTraceForItems(false),
+	bItemTraceDirty(false),
+	bItemTracePending(false),
+	ItemTraceViewLocation(FVector::ZeroVector),
+	ItemTraceViewRotation(FQuat::Identity),
+	ItemTraceMoveThreshold(5.0f),
+	ItemTraceAngleThreshold(0.5f),
+	ItemTraceDistance(5000.0f),
 
 	CameraInterpDistance(150.0f),
 	CameraInterpElevation(40.0f),
@@ -150,9 +161,6 @@ AShooterCharacter::AShooterCharacter() :
 	HealthComponent = CreateDefaultSubobject<UHealthComponent>(TEXT("CharacterHealthComponent"));
 	InventoryComponent = CreateDefaultSubobject<UInventoryComponent>(TEXT("CharacterInventoryComponent"));
 
-	AudioComponent = CreateDefaultSubobject<UAudioComponent>(TEXT("CharacterAudioComponent"));
-	AudioComponent->SetupAttachment(GetRootComponent());
-
 	ShooterPlayerController = Cast<AShooterPlayerController>(GetController());
 }
 
@@ -162,8 +170,8 @@ float AShooterCharacter::TakeDamage(float DamageAmount, const FDamageEvent& Dama
 
 	HealthComponent->OnTakeDamage(DamageAmount, DamageCauser, EventInstigator);
 
-	PlayTheSound("HitHurtSound", true, false, 1.0f);
-	PlayTheSound("HitSound", true, false, 5.0f);
+	PlayTheSound(ESoundType::EST_HitHurtSound, true, false, 1.0f);
+	PlayTheSound(ESoundType::EST_HitSound, true, false, 5.0f);
 
 	DetermineStunChance();
 
@@ -173,7 +181,7 @@ float AShooterCharacter::TakeDamage(float DamageAmount, const FDamageEvent& Dama
 void AShooterCharacter::ProcessDamageBasic_Implementation(const float& DamageAmount, AActor* Shooter, AController* ShooterController)
 {
 	if(BloodParticles)
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BloodParticles, GetActorLocation());
+		UFXPoolSubsystem::SpawnEffect(this, BloodParticles, EFXCategory::EFXC_Blood, GetActorLocation());
 
 	UGameplayStatics::ApplyDamage(this, DamageAmount, ShooterController, Shooter, UDamageType::StaticClass());
 }
@@ -223,6 +231,11 @@ void AShooterCharacter::BeginPlay()
 	
 	InitInterpLocations();
 
+	AudioVoiceSubsystem = GetWorld()->GetSubsystem<UAudioVoiceSubsystem>();
+
+	if (UFXPoolSubsystem* FXPool = UFXPoolSubsystem::Get(this))
+		FXPool->PrewarmEffect(BloodParticles, EFXCategory::EFXC_Blood);
+
 	if (HealthComponent)
 		HealthComponent->OnHealthDepletedEvent.AddDynamic(this, &AShooterCharacter::OnDeath);
 }
@@ -326,97 +339,89 @@ void AShooterCharacter::StartCrosshairBulletFire()
 		}), ShootTimeDuration, false);
 }
 
-bool AShooterCharacter::TraceUnderCrosshair(FHitResult& OutHitResult, FVector& OutHitLocation)
+void AShooterCharacter::TraceForItems()
 {
-	FVector2D ViewportSixe;
-	if (GEngine && GEngine->GameViewport)
-		GEngine->GameViewport->GetViewportSize(ViewportSixe);
+	SCOPE_CYCLE_COUNTER(STAT_TraceForItems);
 
-	FVector2D CrosshairLocation(ViewportSixe.X * 0.5f, ViewportSixe.Y * 0.5f);
+	if (HealthComponent->IsDead()) return;
 
-	FVector CrosshairWorldPosition;
-	FVector CrosshairWorldDirection;
-	bool bScreenToWorld = UGameplayStatics::DeprojectScreenToWorld(UGameplayStatics::GetPlayerController(this, 0), CrosshairLocation, CrosshairWorldPosition, CrosshairWorldDirection);
-	if (bScreenToWorld)
+	if (!bShouldTraceForItems)
 	{
-		const FVector Start = CrosshairWorldPosition;
-		FVector End = CrosshairWorldPosition + CrosshairWorldDirection * 5000.0f;
-		
-		OutHitLocation = End;
-		GetWorld()->LineTraceSingleByChannel(OutHitResult, Start, End, ECollisionChannel::ECC_Visibility);
-		if (OutHitResult.bBlockingHit)
-		{
-			OutHitLocation = OutHitResult.Location;
-			return true;
-		}
+		//We moved out of Overlapping Sphere
+		SetTraceHitItem(nullptr);
+		return;
 	}
 
-	return false;
+	if (bItemTracePending) return;
+
+	AController* ShooterController = GetController();
+	if (ShooterController == nullptr) return;
+
+	//The crosshair sits in the middle of the screen, so the camera view is the crosshair ray
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	ShooterController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	const FQuat ViewQuat = ViewRotation.Quaternion();
+	if (!bItemTraceDirty
+		&& FVector::DistSquared(ViewLocation, ItemTraceViewLocation) < FMath::Square(ItemTraceMoveThreshold)
+		&& FMath::RadiansToDegrees(ViewQuat.AngularDistance(ItemTraceViewRotation)) < ItemTraceAngleThreshold)
+		return;
+
+	ItemTraceViewLocation = ViewLocation;
+	ItemTraceViewRotation = ViewQuat;
+	bItemTraceDirty = false;
+
+	if (!ItemTraceDelegate.IsBound())
+		ItemTraceDelegate.BindUObject(this, &AShooterCharacter::OnItemTraceDone);
+
+	const FVector End = ViewLocation + ViewQuat.GetForwardVector() * ItemTraceDistance;
+	GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, ViewLocation, End, ECC_ItemTrace, FCollisionQueryParams(SCENE_QUERY_STAT(TraceForItems), false, this), FCollisionResponseParams::DefaultResponseParam, &ItemTraceDelegate);
+
+	bItemTracePending = true;
+	INC_DWORD_STAT(STAT_ItemTracesIssued);
 }
 
-void AShooterCharacter::TraceForItems()
+void AShooterCharacter::OnItemTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
 {
-	if (HealthComponent->IsDead()) return;
+	bItemTracePending = false;
+
+	//Left the overlapping sphere while the trace was in flight
+	if (!bShouldTraceForItems) return;
 
-	if (bShouldTraceForItems)
+	AItem* HitItem = nullptr;
+	for (const FHitResult& Hit : TraceDatum.OutHits)
 	{
-		FHitResult ItemTraceResult;
-		FVector HitLocation;
-		TraceUnderCrosshair(ItemTraceResult, HitLocation);
-		if (ItemTraceResult.bBlockingHit)
-		{
-			TraceHitItem = Cast<AItem>(ItemTraceResult.GetActor());
-			const auto TraceHitWeapon = Cast<AWeapon>(TraceHitItem);
-			/*if (TraceHitWeapon)
-			{
-				if (HighlightedSlot == -1)
-				{
-					//Not currently highlighting a slot
-					HighlightInventorySlot();
-				}
-			}
-			else
-			{
-				//Is Slot being highlighted?
-				if (HighlightedSlot != -1)
-				{
-					//Unhighlight the Inventory slot
-					UnHighlightInventorySlot();
-				}
-			}*/
-			
-			if (TraceHitItem && TraceHitItem->GetItemState() == EItemState::EIS_EquipInterping)
-				TraceHitItem = nullptr;
-
-			if (TraceHitItem && TraceHitItem->GetPickupWidget())
-			{
-				TraceHitItem->GetPickupWidget()->SetVisibility(true);
-				TraceHitItem->EnableCustomDepth();
+		if (!Hit.bBlockingHit) continue;
 
-				//m_TraceHitItem->SetCharacterInventoryFull(Inventory.Num() >= InventoryCapacity);
-			}
+		HitItem = Cast<AItem>(Hit.GetActor());
+		break;
+	}
 
-			//we hit AItem last frame
-			if (TracedItemLastFrame)
-			{
-				//Its a different AItem, so turn off visibility of last traced Item
-				if (TraceHitItem != TracedItemLastFrame)
-				{
-					TracedItemLastFrame->GetPickupWidget()->SetVisibility(false);
-					TracedItemLastFrame->DisableCustomDepth();
-				}
-			}
-
-			//Store a reference to HitItem last frame
-			TracedItemLastFrame = TraceHitItem;
-		}
+	if (HitItem && HitItem->GetItemState() == EItemState::EIS_EquipInterping)
+		HitItem = nullptr;
+
+	SetTraceHitItem(HitItem);
+}
+
+void AShooterCharacter::SetTraceHitItem(AItem* HitItem)
+{
+	TraceHitItem = HitItem;
+
+	if (TraceHitItem && TraceHitItem->GetPickupWidget())
+	{
+		TraceHitItem->GetPickupWidget()->SetVisibility(true);
+		TraceHitItem->EnableCustomDepth();
 	}
-	else if (TracedItemLastFrame)
+
+	//Its a different AItem, so turn off visibility of last traced Item
+	if (TracedItemLastFrame && TracedItemLastFrame != TraceHitItem)
 	{
-		//We moved out of Overlapping Sphere
 		TracedItemLastFrame->GetPickupWidget()->SetVisibility(false);
 		TracedItemLastFrame->DisableCustomDepth();
 	}
+
+	TracedItemLastFrame = TraceHitItem;
 }
 
 void AShooterCharacter::Interact()
@@ -429,6 +434,7 @@ void AShooterCharacter::Interact()
 	//TraceHitItem->SetCharacter(this);
 	//TraceHitItem->FinishInterping();
 	TraceHitItem->StartItemCurve(this, true);
+	bItemTraceDirty = true;
 
 	CombatState = ECombatState::ECS_PickingUp;
 
@@ -442,7 +448,7 @@ void AShooterCharacter::PlayKillTauntSound()
 {
 	if (!bCanKillTaunt) return;
 
-	PlayTheSound("KillTauntSound", false, false, 1.0f);
+	PlayTheSound(ESoundType::EST_KillTauntSound, false, false, 1.0f);
 
 	bCanKillTaunt = false;
 	GetWorldTimerManager().SetTimer(KillTauntTimer, FTimerDelegate::CreateLambda([&] { bCanKillTaunt = true; }), KillTauntTime, false);
@@ -475,13 +481,13 @@ void AShooterCharacter::OnDeath(AActor* InstigatorActor, AController* Instigator
 	auto EnemyController = Cast<AEnemyController>(InstigatorController);
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsObject(TEXT("Target"), nullptr);
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("TargetDead"), true);
+		EnemyController->SetBlackboardObject(EnemyController->GetBlackboardKeys().Target, nullptr);
+		EnemyController->SetBlackboardBool(EnemyController->GetBlackboardKeys().TargetDead, true);
 	}
 
 	if (bAiming) StopAiming();
 
-	PlayTheSound("DeathSound", true, false, 1.0f);
+	PlayTheSound(ESoundType::EST_DeathSound, true, false, 1.0f);
 
 	if (InventoryComponent->GetEquippedWeapon())
 	{
@@ -533,7 +539,7 @@ void AShooterCharacter::ThrowGrenade()
 
 	if (bTauntInGrenadeThrow)
 	{
-		PlayTheSound("ThrowGrenadeSound", true, false, 1.0f);
+		PlayTheSound(ESoundType::EST_ThrowGrenadeSound, true, false, 1.0f);
 
 		bTauntInGrenadeThrow = false;
 		GetWorldTimerManager().SetTimer(ThrowGrenadeTauntTimer, FTimerDelegate::CreateLambda([&]
@@ -562,7 +568,7 @@ void AShooterCharacter::ThrowGrenade()
 
 void AShooterCharacter::DetermineStunChance()
 {
-	const float StunningChance = FMath::FRandRange(0.0f, 1.0f);
+	const float StunningChance = URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::CombatStream).FRandRange(0.0f, 1.0f);
 	if (StunningChance <= StunChance) Stun();
 }
 
@@ -710,7 +716,7 @@ void AShooterCharacter::Jump()
 	else
 	{
 		if (!GetCharacterMovement()->IsFalling())
-			PlayTheSound("JumpSound", true, false, 1.0f);
+			PlayTheSound(ESoundType::EST_JumpSound, true, false, 1.0f);
 
 		ACharacter::Jump();
 	}
@@ -722,7 +728,7 @@ void AShooterCharacter::Landed(const FHitResult& Hit)
 	
 	if (HealthComponent == nullptr || HealthComponent->IsDead()) return;
 
-	PlayTheSound("LandSound", true, false, 1.0f);
+	PlayTheSound(ESoundType::EST_LandSound, true, false, 1.0f);
 }
 
 void AShooterCharacter::InterpCapsuleHeights(float DeltaTime)
@@ -886,6 +892,8 @@ void AShooterCharacter::FinishPickup()
 
 void AShooterCharacter::IncrementOverlappedItemCount(int8 Amount)
 {
+	bItemTraceDirty = true;
+
 	if (OverlappedItemCount + Amount <= 0)
 	{
 		OverlappedItemCount = 0;
@@ -935,17 +943,21 @@ void AShooterCharacter::Stun()
 
 void AShooterCharacter::PlayTheSound(const FString& SoundName, bool bFadeIn, bool bFadeOut, float VolumeMultiplier)
 {
-	if (AudioComponent == nullptr || SoundsDataAsset == nullptr) return;
-	if (!SoundsDataAsset->AudioMap.Contains(SoundName) || SoundsDataAsset->AudioMap[SoundName] == nullptr) return;
+	if (SoundsDataAsset == nullptr || AudioVoiceSubsystem == nullptr) return;
 
-	auto& Sound = SoundsDataAsset->AudioMap[SoundName];
-	AudioComponent->SetSound(Sound);
-	AudioComponent->SetVolumeMultiplier(VolumeMultiplier);
+	//Names outside ESoundType still resolve through the registry and play as Misc voices
+	const EVoiceCategory Category = UAudioVoiceSubsystem::GetCategoryForSound(FIndexedSoundRegistry::GetSoundType(SoundName));
+	AudioVoiceSubsystem->PlayActorSound(this, SoundsDataAsset->SoundRegistry.Find(SoundName), Category, bFadeIn, bFadeOut, VolumeMultiplier);
+}
 
-	if (bFadeIn)
-		AudioComponent->FadeIn(0.5f);
-	else if (bFadeOut)
-		AudioComponent->FadeOut(0.5f, 1.0f);
-	else
-		AudioComponent->Play();
+void AShooterCharacter::PlayTheSound(ESoundType SoundType, bool bFadeIn, bool bFadeOut, float VolumeMultiplier)
+{
+	if (SoundsDataAsset == nullptr || AudioVoiceSubsystem == nullptr) return;
+
+	AudioVoiceSubsystem->PlayActorSound(this, SoundsDataAsset->SoundRegistry.Get(SoundType), UAudioVoiceSubsystem::GetCategoryForSound(SoundType), bFadeIn, bFadeOut, VolumeMultiplier);
+}
+
+UAudioComponent* AShooterCharacter::GetAudioComponent() const
+{
+	return AudioVoiceSubsystem ? AudioVoiceSubsystem->GetLatestVoiceOf(this) : nullptr;
 }
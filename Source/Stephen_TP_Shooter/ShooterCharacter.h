@@ -8,6 +8,8 @@
 #include "IShooterActions.h"
 #include "IDamageable.h"
 #include "AmmoType.h"
+#include "SoundType.h"
+#include "WorldCollision.h"
 #include "ShooterCharacter.generated.h"
 
 class AGrenade;
@@ -19,6 +21,7 @@ class UHealthComponent;
 class UInventoryComponent;
 class USoundsDataAsset;
 
+class UAudioVoiceSubsystem;
 class UAudioComponent;
 class USpringArmComponent;
 class UCameraComponent;
@@ -129,12 +132,15 @@ protected:
 
 	//========================================================================================
 
-	// Line Trace for Under Crosshair
-	bool TraceUnderCrosshair(FHitResult& OutHitResult, FVector& OutHitLocation);
-
-	//Trace for Items if Overlapped Items is greater than 0
+	//Issues an async item trace from the camera when the view or the overlapped items changed
 	void TraceForItems();
 
+	//Result of the async item trace, arrives on the next frame
+	void OnItemTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	//Shows the widget and outline of the new item and hides them on the previous one
+	void SetTraceHitItem(AItem* HitItem);
+
 	//Fire Weapon Functions
 	void PlayGunFireMontage();
 
@@ -188,9 +194,9 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UHealthComponent> HealthComponent;
 
-	//Audio Components that plays various sounds from SoundsDataAsset
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UAudioComponent> AudioComponent;
+	//Plays the sounds from SoundsDataAsset through the world voice pool
+	UPROPERTY()
+	TObjectPtr<UAudioVoiceSubsystem> AudioVoiceSubsystem;
 
 	//Stores all sounds data for each character
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
@@ -264,9 +270,33 @@ private:
 	bool bFiringBullet;
 	FTimerHandle CrosshairShootTimer;
 
-	//True, if trace every frame for items
+	//True, if overlapping any item
 	bool bShouldTraceForItems;
 
+	//Set when the overlapped items change, forces the next item trace
+	bool bItemTraceDirty;
+
+	//An async item trace is in flight
+	bool bItemTracePending;
+
+	//Camera view the last item trace was issued from
+	FVector ItemTraceViewLocation;
+	FQuat ItemTraceViewRotation;
+
+	//Camera has to move this far before items are traced again
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
+	float ItemTraceMoveThreshold;
+
+	//Camera has to turn this many degrees before items are traced again
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
+	float ItemTraceAngleThreshold;
+
+	//Length of the item trace from the camera
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
+	float ItemTraceDistance;
+
+	FTraceDelegate ItemTraceDelegate;
+
 	//Number of overlapped items
 	int8 OverlappedItemCount;
 
@@ -426,6 +456,13 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void PlayTheSound(const FString& SoundName, bool bFadeIn, bool bFadeOut, float VolumeMultiplier);
 
+	//Indexed lookup used by native code, the FString overload is kept for Blueprints
+	void PlayTheSound(ESoundType SoundType, bool bFadeIn, bool bFadeOut, float VolumeMultiplier);
+
+	//Voice currently playing for this Character, replaces the old AudioComponent property in Blueprints
+	UFUNCTION(BlueprintPure)
+	UAudioComponent* GetAudioComponent() const;
+
 	FORCEINLINE TObjectPtr<USpringArmComponent> GetCameraBoom() const { return CameraBoom; }
 	FORCEINLINE TObjectPtr<UCameraComponent> GetFollowCamera() const { return FollowCamera; }
 	FORCEINLINE TObjectPtr<UInventoryComponent> GetInventoryComponent() const { return InventoryComponent; }
@@ -6,6 +6,7 @@
 #include "ShooterCharacter.h"
 #include "ShooterPlayerController.h"
 #include "ShooterGameState.h"
+#include "SurvivalBenchmarkSubsystem.h"
 
 AShooterGameMode::AShooterGameMode() : 
 	GameStartCountDown(3),
@@ -19,4 +20,35 @@ AShooterGameMode::AShooterGameMode() :
 	DefaultPawnClass = AShooterCharacter::StaticClass();
 	PlayerControllerClass = AShooterPlayerController::StaticClass();
 	GameStateClass = AShooterGameState::StaticClass();
+}
+
+void AShooterGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	if (USurvivalBenchmarkSubsystem::IsBenchmarkRun())
+		ApplyBenchmarkOverrides();
+}
+
+void AShooterGameMode::ApplyBenchmarkOverrides()
+{
+	const FSurvivalBenchmarkSettings Settings = FSurvivalBenchmarkSettings::FromCommandLine();
+
+	//No need to wait on HUD countdowns when nobody is watching
+	GameStartCountDown = 1;
+	WavesPauseCountDown = 1;
+
+	if (Settings.Waves > 0)
+		WavesMax = (uint8)FMath::Clamp(Settings.Waves, 1, 255);
+
+	WavesMax = (uint8)FMath::Min((int32)WavesMax, MonsterWavesData.Num());
+
+	for (FMonsterWaveData& WaveData : MonsterWavesData)
+	{
+		if (Settings.MonstersPerWave > 0)
+			WaveData.MonstersCount = (uint8)FMath::Clamp(Settings.MonstersPerWave, 1, 255);
+
+		if (Settings.MaxMonstersAlive > 0)
+			WaveData.MaxMonsters = (uint8)FMath::Clamp(Settings.MaxMonstersAlive, 1, 255);
+	}
 }
\ No newline at end of file
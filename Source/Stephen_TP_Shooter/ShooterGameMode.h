@@ -38,8 +38,13 @@ class STEPHEN_TP_SHOOTER_API AShooterGameMode : public AGameModeBase
 
 public:
 	AShooterGameMode();
+
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 	
 private:
+	//Overrides wave rules from the -SurvivalBenchmark command line options
+	void ApplyBenchmarkOverrides();
+
 	/* Count down at the fresh start of game */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	uint8 GameStartCountDown;
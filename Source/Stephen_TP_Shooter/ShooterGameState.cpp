@@ -9,6 +9,11 @@
 #include "ShooterPlayerController.h"
 #include "EnemyManagerSubsystem.h"
 #include "MonsterSpawnPoint.h"
+#include "SpawnPointEvaluatorSubsystem.h"
+#include "MonsterSpawnBakeData.h"
+#include "RandomStreamSubsystem.h"
+#include "SurvivalBenchmarkSubsystem.h"
+#include "Stephen_TP_Shooter.h"
 
 #include "Kismet/GameplayStatics.h"
 
@@ -23,6 +28,7 @@ AShooterGameState::AShooterGameState() :
 void AShooterGameState::HandleBeginPlay()
 {
 	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AMonsterSpawnPoint::StaticClass(), MonsterSpawnPointsList);
+	RejectBakedSpawnPoints();
 
 	ShooterGameMode = Cast<AShooterGameMode>(GetWorld()->GetAuthGameMode());
 	ShooterCharacter = Cast<AShooterCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
@@ -33,6 +39,9 @@ void AShooterGameState::HandleBeginPlay()
 	EnemyManager->OnEnemySpawnDelegate.AddDynamic(this, &AShooterGameState::OnEnemySpawn);
 	EnemyManager->OnEnemyDeathDelegate.AddDynamic(this, &AShooterGameState::OnEnemyDeath);
 
+	SpawnPointEvaluator = GetWorld()->GetSubsystem<USpawnPointEvaluatorSubsystem>();
+	SpawnPointEvaluator->SetSpawnPoints(MonsterSpawnPointsList);
+
 	MatchState = EMatchState::EMS_PreStart;
 
 	WaveCurrent = 0;
@@ -40,6 +49,8 @@ void AShooterGameState::HandleBeginPlay()
 
 	GetWorldTimerManager().SetTimer(MatchPreStartDelayTimerHandle, FTimerDelegate::CreateLambda([&]
 	{
+		PrewarmMonsterPool(WaveCurrent);
+
 		GetWorldTimerManager().SetTimer(MatchPreStartTimerHandle, this, &AShooterGameState::StartSurvivalMatch, ShooterGameMode->GetGameStartCountDown(), false);
 
 		if (OnSurvivalPreStartDelegate.IsBound())
@@ -80,10 +91,20 @@ void AShooterGameState::StartWave()
 	MonsterWaveDataCurrent = ShooterGameMode->GetMonsterWaveDataFromIndex(WaveCurrent - 1);
 	MonstersCountCurrentWave = MonsterWaveDataCurrent.MonstersCount;
 
+	PrewarmMonsterPool(WaveCurrent - 1);
+	EnemyManager->ConfigureAnimationBudget(MonsterWaveDataCurrent.MaxMonsters);
+
+	//First batch is ready long before the first spawn tick, each tick then queues the next one
+	SpawnPointEvaluator->RequestEvaluation(ShooterCharacter);
+
 	GetWorldTimerManager().SetTimer(MonsterSpawnTimerHandle, FTimerDelegate::CreateLambda([&]
 		{
 			SpawnMonster(GetValidMonsterSpawnPoint());
+			SpawnPointEvaluator->RequestEvaluation(ShooterCharacter);
 		}), ShooterGameMode->GetMonstersSpawnDelay(), true);
+
+	if (OnSurvivalWaveStartDelegate.IsBound())
+		OnSurvivalWaveStartDelegate.Broadcast(WaveCurrent);
 }
 
 void AShooterGameState::EndWave()
@@ -98,6 +119,8 @@ void AShooterGameState::EndWave()
 
 void AShooterGameState::StartWavePause()
 {
+	PrewarmMonsterPool(WaveCurrent);
+
 	GetWorldTimerManager().SetTimer(MatchPreStartDelayTimerHandle, FTimerDelegate::CreateLambda([&]
 	{
 		if (OnSurvivalWavePauseStartDelegate.IsBound())
@@ -115,25 +138,47 @@ void AShooterGameState::EndWavePause()
 		OnSurvivalWavePauseEndDelegate.Broadcast();
 }
 
-AMonsterSpawnPoint* AShooterGameState::GetValidMonsterSpawnPoint()
+void AShooterGameState::RejectBakedSpawnPoints()
 {
-	if (MonsterSpawnPointsList.IsEmpty()) return nullptr;
+	MonsterSpawnBakeData = UMonsterSpawnBakeData::LoadForWorld(GetWorld());
+	if (MonsterSpawnBakeData == nullptr) return;
 
-	AMonsterSpawnPoint* SpawnPoint = nullptr;
+	TArray<AActor*> UsableSpawnPoints;
+	for (AActor* SpawnPoint : MonsterSpawnPointsList)
+	{
+		if (SpawnPoint && MonsterSpawnBakeData->IsSpawnPointUsable(SpawnPoint->GetFName()))
+			UsableSpawnPoints.Add(SpawnPoint);
+	}
 
-	int randIndex = FMath::RandRange(0, MonsterSpawnPointsList.Num() - 1);
-	if (MonsterSpawnPointsList.IsValidIndex(randIndex))
+	//A stale bake shouldn't be able to stop spawning altogether
+	if (UsableSpawnPoints.IsEmpty())
 	{
-		if (auto CurrentSpawnPointAtIndex = Cast<AMonsterSpawnPoint>(MonsterSpawnPointsList[randIndex]))
-		{
-			if (!CurrentSpawnPointAtIndex->IsVisibleToPlayer() && !CurrentSpawnPointAtIndex->IsOccupied())
-			{
-				SpawnPoint = CurrentSpawnPointAtIndex;
-			}
-		}
+		UE_LOG(LogGunBound, Warning, TEXT("Spawn bake for %s rejects every spawn point, ignoring it"), *GetWorld()->GetMapName());
+		return;
 	}
 
-	return SpawnPoint;
+	MonsterSpawnPointsList = MoveTemp(UsableSpawnPoints);
+}
+
+void AShooterGameState::PrewarmMonsterPool(int32 WaveIndex)
+{
+	if (EnemyManager == nullptr || ShooterGameMode == nullptr) return;
+	if (WaveIndex < 0 || WaveIndex >= WaveMax) return;
+
+	const FMonsterWaveData WaveData = ShooterGameMode->GetMonsterWaveDataFromIndex(WaveIndex);
+	if (WaveData.EnemyTypes.IsEmpty()) return;
+
+	//MaxMonsters can be alive at once, split between the wave's enemy types
+	const int32 PerTypeCount = FMath::DivideAndRoundUp((int32)WaveData.MaxMonsters, WaveData.EnemyTypes.Num());
+	for (const TSubclassOf<AEnemy>& EnemyType : WaveData.EnemyTypes)
+		EnemyManager->PrewarmPool(EnemyType, PerTypeCount, WaveData.MaxMonsters);
+}
+
+AMonsterSpawnPoint* AShooterGameState::GetValidMonsterSpawnPoint()
+{
+	if (SpawnPointEvaluator == nullptr) return nullptr;
+
+	return SpawnPointEvaluator->PickValidSpawnPoint();
 }
 
 void AShooterGameState::SpawnMonster(AMonsterSpawnPoint* SpawnPoint)
@@ -141,14 +186,19 @@ void AShooterGameState::SpawnMonster(AMonsterSpawnPoint* SpawnPoint)
 	if (SpawnPoint == nullptr) return;
 	if (MonsterWaveDataCurrent.EnemyTypes.IsEmpty()) return;
 
-	TSubclassOf<AEnemy> MonsterType = MonsterWaveDataCurrent.EnemyTypes[FMath::RandRange(0, MonsterWaveDataCurrent.EnemyTypes.Num() - 1)];
+	const double SpawnStartTime = FPlatformTime::Seconds();
+
+	FRandomStream& SpawnStream = URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::SpawnStream);
+	TSubclassOf<AEnemy> MonsterType = MonsterWaveDataCurrent.EnemyTypes[SpawnStream.RandRange(0, MonsterWaveDataCurrent.EnemyTypes.Num() - 1)];
 
-	auto NewEnemy = GetWorld()->SpawnActor<AEnemy>(MonsterType);
+	auto NewEnemy = EnemyManager->AcquireEnemy(MonsterType, SpawnPoint->GetActorTransform());
 	if (NewEnemy)
 	{
-		NewEnemy->SetActorTransform(SpawnPoint->GetActorTransform());
+		SpawnPoint->AddOccupant(NewEnemy);
 		NewEnemy->DetectPlayer(ShooterCharacter);
 	}
+
+	USurvivalBenchmarkSubsystem::AddSpawnTime(FPlatformTime::Seconds() - SpawnStartTime);
 }
 
 void AShooterGameState::OnEnemySpawn(AEnemy* Enemy)
@@ -189,6 +239,9 @@ void AShooterGameState::OnEnemyDeath(AEnemy* Enemy)
 
 	if (MonstersCountCurrent <= 0 && MonstersCountCurrentWave <= 0)
 	{
+		if (OnSurvivalWaveEndDelegate.IsBound())
+			OnSurvivalWaveEndDelegate.Broadcast(WaveCurrent);
+
 		(WaveCurrent < WaveMax) ? EndWave() : EndSurvivalMatch(true);
 	}
 	else if(MonstersCountCurrent < MonsterWaveDataCurrent.MaxMonsters && MonstersCountCurrentWave > 0 &&
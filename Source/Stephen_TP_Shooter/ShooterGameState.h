@@ -11,6 +11,8 @@ class AShooterCharacter;
 class AShooterPlayerController;
 class AMonsterSpawnPoint;
 class UEnemyManagerSubsystem;
+class USpawnPointEvaluatorSubsystem;
+class UMonsterSpawnBakeData;
 
 UENUM(BlueprintType)
 enum class EMatchState : uint8
@@ -25,6 +27,7 @@ enum class EMatchState : uint8
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSurvivalEvent);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSurvivalEndEvent, bool, bVictory);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSurvivalWaveEvent, int32, Wave);
 
 UCLASS()
 class STEPHEN_TP_SHOOTER_API AShooterGameState : public AGameStateBase
@@ -46,6 +49,12 @@ private:
 	void StartWavePause();
 	void EndWavePause();
 
+	//Drops spawn points the offline bake marked as unreachable or usually visible
+	void RejectBakedSpawnPoints();
+
+	//Fills the Enemy Manager pools for the given wave so spawning doesn't hitch mid wave
+	void PrewarmMonsterPool(int32 WaveIndex);
+
 	AMonsterSpawnPoint* GetValidMonsterSpawnPoint();
 	void SpawnMonster(AMonsterSpawnPoint* SpawnPoint);
 
@@ -71,6 +80,14 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Match Delegates", meta = (AllowPrivateAccess = "true"))
 	FOnSurvivalEndEvent OnSurvivalEndDelegate;
 
+	//Delegate for a wave starting to spawn monsters
+	UPROPERTY(BlueprintAssignable, Category = "Match Delegates", meta = (AllowPrivateAccess = "true"))
+	FOnSurvivalWaveEvent OnSurvivalWaveStartDelegate;
+
+	//Delegate for the last monster of a wave being killed
+	UPROPERTY(BlueprintAssignable, Category = "Match Delegates", meta = (AllowPrivateAccess = "true"))
+	FOnSurvivalWaveEvent OnSurvivalWaveEndDelegate;
+
 	//Delegate for Wave Pause start (used for playing HUD FadeIn/Out Animations)
 	UPROPERTY(BlueprintAssignable, Category = "Match Delegates", meta = (AllowPrivateAccess = "true"))
 	FOnSurvivalEvent OnSurvivalWavePauseStartDelegate;
@@ -96,6 +113,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Match State", meta = (AllowPrivateAccess = "true"))
 	UEnemyManagerSubsystem* EnemyManager;
 
+	/*Async evaluator that keeps the set of spawn points hidden from the player*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Match State", meta = (AllowPrivateAccess = "true"))
+	USpawnPointEvaluatorSubsystem* SpawnPointEvaluator;
+
 	/*Current State of Survival Game mode*/
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Match State", meta = (AllowPrivateAccess = "true"))
 	EMatchState MatchState;
@@ -119,6 +140,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Match State", meta = (AllowPrivateAccess = "true"))
 	TArray<AActor*> MonsterSpawnPointsList;
 
+	/*Offline baked visibility/reachability of this map's spawn points, null if the map was never baked*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Match State", meta = (AllowPrivateAccess = "true"))
+	UMonsterSpawnBakeData* MonsterSpawnBakeData;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Match State", meta = (AllowPrivateAccess = "true"))
 	FMonsterWaveData MonsterWaveDataCurrent;
 
@@ -4,6 +4,7 @@
 #include "ShooterPlayerController.h"
 #include "ShooterCharacter.h"
 #include "ShooterGameState.h"
+#include "HitNumberComponent.h"
 
 #include "Kismet/GameplayStatics.h"
 #include "Blueprint/UserWidget.h"
@@ -29,6 +30,7 @@ AShooterPlayerController::AShooterPlayerController() :
 	bAiming(false),
 	bFireButtonPressed(false)
 {
+	HitNumberComponent = CreateDefaultSubobject<UHitNumberComponent>(TEXT("HitNumberComponent"));
 }
 
 void AShooterPlayerController::BeginPlay()
@@ -8,6 +8,7 @@
 
 class AShooterCharacter;
 class AShooterGameState;
+class UHitNumberComponent;
 
 UCLASS()
 class STEPHEN_TP_SHOOTER_API AShooterPlayerController : public APlayerController
@@ -62,6 +63,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Character, meta = (AllowPrivateAccess = "true"))
 	AShooterGameState* ShooterGameState;
 
+	//Pools and lays out the floating damage numbers of every Enemy
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Widgets, meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UHitNumberComponent> HitNumberComponent;
+
 	//Reference to Pre Start Overlay Class
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Widgets, meta = (AllowPrivateAccess = "true"))
 	TSubclassOf<UUserWidget> HUDPreStartOverlayClass;
@@ -124,6 +129,7 @@ private:
 
 public:
 	TObjectPtr<UUserWidget> GetHUDOverlay() const { return HUDOverlay; }
+	FORCEINLINE TObjectPtr<UHitNumberComponent> GetHitNumberComponent() const { return HitNumberComponent; }
 
 	FORCEINLINE bool IsAiming() const { return bAiming; }
 	FORCEINLINE bool IsFireButtonHeld() const { return bFireButtonPressed; }
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SoundType.generated.h"
+
+UENUM(BlueprintType)
+enum class ESoundType : uint8
+{
+	EST_HitSound UMETA(DisplayName = "Hit Sound"),
+	EST_HitHurtSound UMETA(DisplayName = "Hit Hurt Sound"),
+	EST_BulletHitSound UMETA(DisplayName = "Bullet Hit Sound"),
+	EST_DeathSound UMETA(DisplayName = "Death Sound"),
+	EST_AttackSound UMETA(DisplayName = "Attack Sound"),
+	EST_AxeSwingSound UMETA(DisplayName = "Axe Swing Sound"),
+	EST_GreetSound UMETA(DisplayName = "Greet Sound"),
+	EST_StunSound UMETA(DisplayName = "Stun Sound"),
+	EST_JumpSound UMETA(DisplayName = "Jump Sound"),
+	EST_LandSound UMETA(DisplayName = "Land Sound"),
+	EST_KillTauntSound UMETA(DisplayName = "Kill Taunt Sound"),
+	EST_ThrowGrenadeSound UMETA(DisplayName = "Throw Grenade Sound"),
+
+	EST_MAX UMETA(DisplayName = "Default MAX")
+};
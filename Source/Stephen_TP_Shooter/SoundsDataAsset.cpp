@@ -3,3 +3,19 @@
 
 #include "SoundsDataAsset.h"
 
+
+void USoundsDataAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	SoundRegistry.Build(AudioMap);
+}
+
+#if WITH_EDITOR
+void USoundsDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	SoundRegistry.Build(AudioMap);
+}
+#endif
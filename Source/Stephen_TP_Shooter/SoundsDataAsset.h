@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 #include "Sound/SoundCue.h"
+#include "IndexedSoundRegistry.h"
 #include "SoundsDataAsset.generated.h"
 
 /**
@@ -16,6 +17,15 @@ class STEPHEN_TP_SHOOTER_API USoundsDataAsset : public UDataAsset
 	GENERATED_BODY()
 	
 public:
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Audio")
 	TMap<FString, TObjectPtr<USoundCue>> AudioMap;
+
+	//AudioMap resolved by ESoundType, rebuilt whenever AudioMap is loaded or edited
+	FIndexedSoundRegistry SoundRegistry;
 };
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SpawnPointEvaluatorSubsystem.h"
+#include "MonsterSpawnPoint.h"
+#include "ShooterCharacter.h"
+#include "RandomStreamSubsystem.h"
+
+#include "Engine/World.h"
+
+void USpawnPointEvaluatorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PendingTraceCount = 0;
+	BatchId = 0;
+
+	VisibilityTraceDelegate.BindUObject(this, &USpawnPointEvaluatorSubsystem::OnVisibilityTraceDone);
+}
+
+void USpawnPointEvaluatorSubsystem::Deinitialize()
+{
+	VisibilityTraceDelegate.Unbind();
+
+	SpawnPoints.Empty();
+	ValidSpawnPoints.Empty();
+
+	Super::Deinitialize();
+}
+
+void USpawnPointEvaluatorSubsystem::SetSpawnPoints(const TArray<AActor*>& InSpawnPoints)
+{
+	SpawnPoints.Reset();
+	ValidSpawnPoints.Reset();
+
+	for (AActor* SpawnPointActor : InSpawnPoints)
+	{
+		if (auto SpawnPoint = Cast<AMonsterSpawnPoint>(SpawnPointActor))
+			SpawnPoints.Add(SpawnPoint);
+	}
+}
+
+void USpawnPointEvaluatorSubsystem::RequestEvaluation(AShooterCharacter* Player)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr || Player == nullptr) return;
+	if (SpawnPoints.IsEmpty()) return;
+
+	//Starting a new batch drops whatever is still in flight
+	BatchId++;
+	EvaluatedPlayer = Player;
+
+	PendingVisible.Init(false, SpawnPoints.Num());
+	PendingFacedByPlayer.Init(false, SpawnPoints.Num());
+	PendingTraceCount = 0;
+
+	for (int32 i = 0; i < SpawnPoints.Num(); i++)
+	{
+		AMonsterSpawnPoint* SpawnPoint = SpawnPoints[i];
+		if (SpawnPoint == nullptr) continue;
+
+		FVector StartTrace, EndTrace;
+		SpawnPoint->GetVisibilityTrace(*Player, StartTrace, EndTrace);
+		PendingFacedByPlayer[i] = SpawnPoint->IsFacedByPlayer(*Player, EndTrace);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SpawnPointVisibility));
+		QueryParams.AddIgnoredActor(SpawnPoint);
+
+		const uint32 UserData = ((uint32)BatchId << 16) | (uint32)i;
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartTrace, EndTrace, ECollisionChannel::ECC_Pawn, QueryParams, FCollisionResponseParams::DefaultResponseParam, &VisibilityTraceDelegate, UserData);
+
+		PendingTraceCount++;
+	}
+}
+
+void USpawnPointEvaluatorSubsystem::OnVisibilityTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	if ((uint16)(TraceDatum.UserData >> 16) != BatchId) return;
+
+	const int32 Index = (int32)(TraceDatum.UserData & 0xFFFF);
+	if (!PendingVisible.IsValidIndex(Index)) return;
+
+	const bool bBlockHit = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+	PendingVisible[Index] = bBlockHit && TraceDatum.OutHits[0].GetActor() == EvaluatedPlayer.Get() && PendingFacedByPlayer[Index];
+
+	PendingTraceCount--;
+	if (PendingTraceCount <= 0)
+		FinishEvaluation();
+}
+
+void USpawnPointEvaluatorSubsystem::FinishEvaluation()
+{
+	PendingTraceCount = 0;
+	ValidSpawnPoints.Reset();
+
+	for (int32 i = 0; i < SpawnPoints.Num(); i++)
+	{
+		if (SpawnPoints[i] && !PendingVisible[i])
+			ValidSpawnPoints.Add(SpawnPoints[i]);
+	}
+}
+
+AMonsterSpawnPoint* USpawnPointEvaluatorSubsystem::PickValidSpawnPoint()
+{
+	FRandomStream& SpawnStream = URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::SpawnStream);
+
+	while (ValidSpawnPoints.Num() > 0)
+	{
+		const int32 RandIndex = SpawnStream.RandRange(0, ValidSpawnPoints.Num() - 1);
+		AMonsterSpawnPoint* SpawnPoint = ValidSpawnPoints[RandIndex];
+		ValidSpawnPoints.RemoveAtSwap(RandIndex, 1, false);
+
+		if (SpawnPoint && !SpawnPoint->IsOccupied())
+			return SpawnPoint;
+	}
+
+	return nullptr;
+}
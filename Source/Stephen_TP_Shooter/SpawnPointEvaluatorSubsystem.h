@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "SpawnPointEvaluatorSubsystem.generated.h"
+
+class AMonsterSpawnPoint;
+class AShooterCharacter;
+
+/*
+* Evaluates every Monster Spawn Point with one batch of async visibility traces per spawn interval.
+* The spawner picks from the cached "valid now" set instead of tracing a random point on the game thread.
+*/
+UCLASS()
+class STEPHEN_TP_SHOOTER_API USpawnPointEvaluatorSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void SetSpawnPoints(const TArray<AActor*>& InSpawnPoints);
+
+	//Issues async visibility traces from every spawn point toward the Player, results land next frame
+	void RequestEvaluation(AShooterCharacter* Player);
+
+	//Returns a random unoccupied spawn point from the last finished evaluation and removes it from the set
+	AMonsterSpawnPoint* PickValidSpawnPoint();
+
+private:
+	void OnVisibilityTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void FinishEvaluation();
+
+	UPROPERTY()
+	TArray<TObjectPtr<AMonsterSpawnPoint>> SpawnPoints;
+
+	//Spawn points hidden from the Player as of the last finished evaluation
+	UPROPERTY()
+	TArray<TObjectPtr<AMonsterSpawnPoint>> ValidSpawnPoints;
+
+	TWeakObjectPtr<AShooterCharacter> EvaluatedPlayer;
+
+	//Per spawn point results of the batch in flight
+	TArray<bool> PendingVisible;
+	TArray<bool> PendingFacedByPlayer;
+	int32 PendingTraceCount;
+
+	//Tags trace UserData so results from an older batch are ignored
+	uint16 BatchId;
+
+	FTraceDelegate VisibilityTraceDelegate;
+
+public:
+	FORCEINLINE int32 GetValidSpawnPointCount() const { return ValidSpawnPoints.Num(); }
+	FORCEINLINE bool IsEvaluationPending() const { return PendingTraceCount > 0; }
+};
@@ -3,4 +3,6 @@
 #include "Stephen_TP_Shooter.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogGunBound);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Stephen_TP_Shooter, "Stephen_TP_Shooter" );
@@ -4,7 +4,17 @@
 
 #include "CoreMinimal.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogGunBound, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("GunBound"), STATGROUP_GunBound, STATCAT_Advanced);
+
 #define EPS_Metal EPhysicalSurface::SurfaceType1
 #define EPS_Stone EPhysicalSurface::SurfaceType2
 #define EPS_Grass EPhysicalSurface::SurfaceType3
-#define EPS_Water EPhysicalSurface::SurfaceType4
\ No newline at end of file
+#define EPS_Water EPhysicalSurface::SurfaceType4
+
+//Trace channel blocked only by item pickup boxes
+#define ECC_ItemTrace ECollisionChannel::ECC_GameTraceChannel1
+
+//Trace channel for hitscan weapons, answered by world geometry and character hitbox bodies only
+#define ECC_WeaponTrace ECollisionChannel::ECC_GameTraceChannel2
@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SurvivalBenchmarkSubsystem.h"
+#include "Stephen_TP_Shooter.h"
+#include "ShooterGameState.h"
+#include "ShooterCharacter.h"
+#include "HealthComponent.h"
+#include "Enemy.h"
+#include "EnemyManagerSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+USurvivalBenchmarkSubsystem* USurvivalBenchmarkSubsystem::ActiveBenchmark = nullptr;
+
+FSurvivalBenchmarkSettings::FSurvivalBenchmarkSettings() :
+	Waves(0),
+	MonstersPerWave(0),
+	MaxMonstersAlive(0),
+	KillInterval(0.5f),
+	Timeout(900.0f)
+{
+	CsvPath = FPaths::ProfilingDir() / TEXT("SurvivalBenchmark.csv");
+}
+
+FSurvivalBenchmarkSettings FSurvivalBenchmarkSettings::FromCommandLine()
+{
+	FSurvivalBenchmarkSettings Settings;
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("BenchmarkWaves="), Settings.Waves);
+	FParse::Value(CommandLine, TEXT("BenchmarkMonsters="), Settings.MonstersPerWave);
+	FParse::Value(CommandLine, TEXT("BenchmarkMaxMonsters="), Settings.MaxMonstersAlive);
+	FParse::Value(CommandLine, TEXT("BenchmarkKillInterval="), Settings.KillInterval);
+	FParse::Value(CommandLine, TEXT("BenchmarkTimeout="), Settings.Timeout);
+	FParse::Value(CommandLine, TEXT("BenchmarkCsv="), Settings.CsvPath);
+
+	return Settings;
+}
+
+bool USurvivalBenchmarkSubsystem::IsBenchmarkRun()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("SurvivalBenchmark"));
+}
+
+bool USurvivalBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return IsBenchmarkRun() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool USurvivalBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USurvivalBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Settings = FSurvivalBenchmarkSettings::FromCommandLine();
+
+	bRecordingWave = false;
+	bFinished = false;
+	FrameStartSeconds = 0.0;
+	BenchmarkStartSeconds = FPlatformTime::Seconds();
+	KillCooldown = Settings.KillInterval;
+
+	ActiveBenchmark = this;
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &USurvivalBenchmarkSubsystem::OnWorldTickStart);
+}
+
+void USurvivalBenchmarkSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+
+	if (ActiveBenchmark == this)
+		ActiveBenchmark = nullptr;
+
+	Super::Deinitialize();
+}
+
+void USurvivalBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	ShooterGameState = Cast<AShooterGameState>(UGameplayStatics::GetGameState(&InWorld));
+	if (ShooterGameState == nullptr)
+	{
+		UE_LOG(LogGunBound, Error, TEXT("Survival benchmark needs a map running AShooterGameState"));
+		WriteCsvAndExit();
+		return;
+	}
+
+	ShooterGameState->OnSurvivalWaveStartDelegate.AddDynamic(this, &USurvivalBenchmarkSubsystem::OnWaveStart);
+	ShooterGameState->OnSurvivalWaveEndDelegate.AddDynamic(this, &USurvivalBenchmarkSubsystem::OnWaveEnd);
+	ShooterGameState->OnSurvivalEndDelegate.AddDynamic(this, &USurvivalBenchmarkSubsystem::OnMatchEnd);
+
+	UE_LOG(LogGunBound, Display, TEXT("Survival benchmark started, results go to %s"), *Settings.CsvPath);
+}
+
+void USurvivalBenchmarkSubsystem::OnWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (TickedWorld == GetWorld())
+		FrameStartSeconds = FPlatformTime::Seconds();
+}
+
+TStatId USurvivalBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USurvivalBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void USurvivalBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bFinished) return;
+
+	if (bRecordingWave && FrameStartSeconds > 0.0)
+	{
+		//Tickables run at the end of the world tick, so this covers the frame's world update
+		const double GameThreadSeconds = FPlatformTime::Seconds() - FrameStartSeconds;
+		CurrentWave.Frames++;
+		CurrentWave.GameThreadSeconds += GameThreadSeconds;
+		CurrentWave.GameThreadMaxSeconds = FMath::Max(CurrentWave.GameThreadMaxSeconds, GameThreadSeconds);
+
+		const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+		CurrentWave.UsedPhysicalPeak = FMath::Max(CurrentWave.UsedPhysicalPeak, UsedPhysical);
+	}
+
+	UpdateStandIn(DeltaTime);
+
+	if (FPlatformTime::Seconds() - BenchmarkStartSeconds > Settings.Timeout)
+	{
+		UE_LOG(LogGunBound, Warning, TEXT("Survival benchmark timed out after %.0f seconds"), Settings.Timeout);
+		WriteCsvAndExit();
+	}
+}
+
+void USurvivalBenchmarkSubsystem::UpdateStandIn(float DeltaTime)
+{
+	if (ShooterCharacter == nullptr && ShooterGameState)
+		ShooterCharacter = ShooterGameState->GetShooterCharacter();
+
+	if (ShooterCharacter == nullptr) return;
+
+	//Stand-in never dies, the benchmark measures the wave loop not the player's skill
+	if (UHealthComponent* PlayerHealth = ShooterCharacter->GetHealthComponent())
+		PlayerHealth->AddHealth(1000.0f);
+
+	if (!bRecordingWave) return;
+
+	KillCooldown -= DeltaTime;
+	if (KillCooldown > 0.0f) return;
+	KillCooldown = Settings.KillInterval;
+
+	AEnemy* Target = FindNearestEnemy(ShooterCharacter->GetActorLocation());
+	if (Target == nullptr) return;
+
+	if (AController* Controller = ShooterCharacter->GetController())
+		Controller->SetControlRotation(UKismetMathLibrary::FindLookAtRotation(ShooterCharacter->GetActorLocation(), Target->GetActorLocation()));
+
+	UGameplayStatics::ApplyDamage(Target, 1000000.0f, ShooterCharacter->GetController(), ShooterCharacter, UDamageType::StaticClass());
+}
+
+AEnemy* USurvivalBenchmarkSubsystem::FindNearestEnemy(const FVector& Location) const
+{
+	//Dead Enemies leave the registry on death, so the nearest entry is always a valid target
+	UEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UEnemyManagerSubsystem>();
+	if (EnemyManager == nullptr) return nullptr;
+
+	TArray<AEnemy*> NearestEnemies;
+	EnemyManager->QueryNearestEnemies(Location, 1, NearestEnemies);
+
+	return NearestEnemies.Num() > 0 ? NearestEnemies[0] : nullptr;
+}
+
+void USurvivalBenchmarkSubsystem::OnWaveStart(int32 Wave)
+{
+	CurrentWave = FSurvivalBenchmarkWaveStats();
+	CurrentWave.Wave = Wave;
+	CurrentWave.StartTime = FPlatformTime::Seconds();
+
+	KillCooldown = Settings.KillInterval;
+	bRecordingWave = true;
+}
+
+void USurvivalBenchmarkSubsystem::OnWaveEnd(int32 Wave)
+{
+	if (!bRecordingWave) return;
+
+	bRecordingWave = false;
+
+	CurrentWave.Duration = FPlatformTime::Seconds() - CurrentWave.StartTime;
+	CurrentWave.UsedPhysicalEnd = FPlatformMemory::GetStats().UsedPhysical;
+	CompletedWaves.Add(CurrentWave);
+
+	UE_LOG(LogGunBound, Display, TEXT("Benchmark wave %d done in %.1fs, %d frames"), Wave, CurrentWave.Duration, CurrentWave.Frames);
+}
+
+void USurvivalBenchmarkSubsystem::OnMatchEnd(bool bVictory)
+{
+	if (bRecordingWave)
+		OnWaveEnd(CurrentWave.Wave);
+
+	WriteCsvAndExit();
+}
+
+void USurvivalBenchmarkSubsystem::AddSpawnTime(double Seconds)
+{
+	if (!IsRecording()) return;
+
+	ActiveBenchmark->CurrentWave.Spawns++;
+	ActiveBenchmark->CurrentWave.SpawnSeconds += Seconds;
+}
+
+void USurvivalBenchmarkSubsystem::AddAITickTime(double Seconds)
+{
+	if (!IsRecording()) return;
+
+	ActiveBenchmark->CurrentWave.AITickSeconds += Seconds;
+}
+
+void USurvivalBenchmarkSubsystem::WriteCsvAndExit()
+{
+	if (bFinished) return;
+	bFinished = true;
+
+	FString Csv = TEXT("Wave,DurationSec,Frames,AvgGameThreadMs,MaxGameThreadMs,Spawns,AvgSpawnMs,TotalSpawnMs,AITickMsPerFrame,UsedPhysicalMB,PeakUsedPhysicalMB\n");
+
+	for (const FSurvivalBenchmarkWaveStats& Stats : CompletedWaves)
+	{
+		const double Frames = FMath::Max(Stats.Frames, 1);
+		const double Spawns = FMath::Max(Stats.Spawns, 1);
+
+		Csv += FString::Printf(TEXT("%d,%.3f,%d,%.3f,%.3f,%d,%.3f,%.3f,%.3f,%.1f,%.1f\n"),
+			Stats.Wave,
+			Stats.Duration,
+			Stats.Frames,
+			Stats.GameThreadSeconds * 1000.0 / Frames,
+			Stats.GameThreadMaxSeconds * 1000.0,
+			Stats.Spawns,
+			Stats.SpawnSeconds * 1000.0 / Spawns,
+			Stats.SpawnSeconds * 1000.0,
+			Stats.AITickSeconds * 1000.0 / Frames,
+			(double)Stats.UsedPhysicalEnd / (1024.0 * 1024.0),
+			(double)Stats.UsedPhysicalPeak / (1024.0 * 1024.0));
+	}
+
+	if (FFileHelper::SaveStringToFile(Csv, *Settings.CsvPath))
+		UE_LOG(LogGunBound, Display, TEXT("Survival benchmark wrote %d waves to %s"), CompletedWaves.Num(), *Settings.CsvPath);
+	else
+		UE_LOG(LogGunBound, Error, TEXT("Survival benchmark failed to write %s"), *Settings.CsvPath);
+
+	FPlatformMisc::RequestExit(false);
+}
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SurvivalBenchmarkSubsystem.generated.h"
+
+class AShooterGameState;
+class AShooterCharacter;
+class AEnemy;
+
+//Benchmark options read from the command line
+struct FSurvivalBenchmarkSettings
+{
+	//Waves to run, 0 keeps the Game Mode value
+	int32 Waves;
+
+	//Monsters per wave, 0 keeps each wave's MonstersCount
+	int32 MonstersPerWave;
+
+	//Monsters alive at once, 0 keeps each wave's MaxMonsters
+	int32 MaxMonstersAlive;
+
+	//Seconds between scripted kills
+	float KillInterval;
+
+	//Hard stop in seconds, in case a wave never finishes
+	float Timeout;
+
+	FString CsvPath;
+
+	FSurvivalBenchmarkSettings();
+
+	static FSurvivalBenchmarkSettings FromCommandLine();
+};
+
+//Metrics of one wave, written as one CSV row
+struct FSurvivalBenchmarkWaveStats
+{
+	int32 Wave = 0;
+	double StartTime = 0.0;
+	double Duration = 0.0;
+	int32 Frames = 0;
+
+	double GameThreadSeconds = 0.0;
+	double GameThreadMaxSeconds = 0.0;
+
+	int32 Spawns = 0;
+	double SpawnSeconds = 0.0;
+
+	double AITickSeconds = 0.0;
+
+	uint64 UsedPhysicalEnd = 0;
+	uint64 UsedPhysicalPeak = 0;
+};
+
+/*
+* Headless survival wave benchmark, only created when the game is launched with -SurvivalBenchmark:
+* UnrealEditor GunBound.uproject /Game/_Game/Maps/Level_Village -game -nullrhi -unattended -SurvivalBenchmark
+*	-benchmark -fps=60 -GameplaySeed=1 [-BenchmarkWaves=5] [-BenchmarkMonsters=30] [-BenchmarkMaxMonsters=15]
+*	[-BenchmarkKillInterval=0.5] [-BenchmarkTimeout=900] [-BenchmarkCsv=Path.csv]
+* A scripted stand-in keeps the player alive and kills the nearest enemy every KillInterval. One CSV row is written per wave.
+*/
+UCLASS()
+class STEPHEN_TP_SHOOTER_API USurvivalBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static bool IsBenchmarkRun();
+
+	//Cheap static hooks for instrumented code, no-ops unless a wave is being recorded
+	static void AddSpawnTime(double Seconds);
+	static void AddAITickTime(double Seconds);
+	static FORCEINLINE bool IsRecording() { return ActiveBenchmark != nullptr && ActiveBenchmark->bRecordingWave; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	UFUNCTION()
+	void OnWaveStart(int32 Wave);
+
+	UFUNCTION()
+	void OnWaveEnd(int32 Wave);
+
+	UFUNCTION()
+	void OnMatchEnd(bool bVictory);
+
+	void OnWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds);
+
+	void UpdateStandIn(float DeltaTime);
+	AEnemy* FindNearestEnemy(const FVector& Location) const;
+
+	void WriteCsvAndExit();
+
+private:
+	static USurvivalBenchmarkSubsystem* ActiveBenchmark;
+
+	FSurvivalBenchmarkSettings Settings;
+
+	UPROPERTY()
+	TObjectPtr<AShooterGameState> ShooterGameState;
+
+	UPROPERTY()
+	TObjectPtr<AShooterCharacter> ShooterCharacter;
+
+	TArray<FSurvivalBenchmarkWaveStats> CompletedWaves;
+	FSurvivalBenchmarkWaveStats CurrentWave;
+
+	bool bRecordingWave;
+	bool bFinished;
+
+	double FrameStartSeconds;
+	double BenchmarkStartSeconds;
+	float KillCooldown;
+
+	FDelegateHandle WorldTickStartHandle;
+};
@@ -7,6 +7,11 @@
 #include "ShooterPlayerController.h"
 #include "BulletHitInterface.h"
 #include "IDamageable.h"
+#include "RandomStreamSubsystem.h"
+#include "AudioVoiceSubsystem.h"
+#include "FXPoolSubsystem.h"
+#include "ItemDefinitionSubsystem.h"
+#include "Stephen_TP_Shooter.h"
 
 #include "Perception/AISense_Hearing.h"
 #include "Particles/ParticleSystemComponent.h"
@@ -14,8 +19,12 @@
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
 
+DECLARE_CYCLE_STAT(TEXT("Weapon Fire Bullets"), STAT_WeaponFireBullets, STATGROUP_GunBound);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon Rounds Per Frame"), STAT_WeaponRoundsPerFrame, STATGROUP_GunBound);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Weapon Achieved RPM"), STAT_WeaponAchievedRPM, STATGROUP_GunBound);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Weapon Nominal RPM"), STAT_WeaponNominalRPM, STATGROUP_GunBound);
+
 AWeapon::AWeapon() :
-	FireMode(EFiringMode::EFM_SemiAuto),
 	Ammo(0),
 	MagCapacity(30),
 	WeaponType(EWeaponType::EWT_SubmachineGun),
@@ -28,9 +37,16 @@ AWeapon::AWeapon() :
 	MaxSlideDisplacement(4.0f),
 	MaxRecoilRotation(20.0f),
 	ThrowWeaponTime(0.7f),
-	RecoilPitch(-0.15f),
 	bFalling(false),
-	RecoilYaw(-0.15f)
+	FireCooldown(0.0f),
+	bFireScheduled(false),
+	BurstRoundsFired(0),
+	BurstStartTime(0.0),
+	BurstStartFrame(0),
+	AchievedRoundsPerMinute(0.0f),
+	MaxRoundsPerFrame(4),
+	BarrelSocket(nullptr),
+	Definition(nullptr)
 {
 	PrimaryActorTick.bCanEverTick = true;
 }
@@ -39,12 +55,15 @@ void AWeapon::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (BoneToHide != FName(""))
-		GetItemMesh()->HideBoneByName(BoneToHide, EPhysBodyOp::PBO_None);
+	//Weapons placed in the level are copied into the game world without running construction again
+	ResolveDefinition();
+
+	if (GetBoneToHide() != NAME_None)
+		GetItemMesh()->HideBoneByName(GetBoneToHide(), EPhysBodyOp::PBO_None);
 
-	if (MuzzleFlashEffect)
+	if (GetMuzzleFlashEffect())
 	{
-		MuzzleFlashComp = UGameplayStatics::SpawnEmitterAttached(MuzzleFlashEffect,
+		MuzzleFlashComp = UGameplayStatics::SpawnEmitterAttached(GetMuzzleFlashEffect(),
 			GetItemMesh(),
 			TEXT("BarrelSocket"),
 			FVector::ZeroVector, FRotator::ZeroRotator, FVector::OneVector,
@@ -52,182 +71,89 @@ void AWeapon::BeginPlay()
 	}
 
 	BarrelSocket = GetItemMesh()->GetSocketByName("BarrelSocket");
+
+	if (UFXPoolSubsystem* FXPool = UFXPoolSubsystem::Get(this))
+	{
+		FXPool->PrewarmEffect(BeamParticleEffect, EFXCategory::EFXC_Beam);
+		FXPool->PrewarmEffect(BulletWallHitEffect, EFXCategory::EFXC_Impact);
+	}
 }
 
 void AWeapon::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
 
-	FString WeaponTablePath = TEXT("/Script/Engine.DataTable'/Game/_Game/DataTable/WeaponDataTable.WeaponDataTable'");
-	UDataTable* WeaponTableObject = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *WeaponTablePath));
-
-	if (WeaponTableObject)
-	{
-		FWeaponDataTable* WeaponDataRow = nullptr;
-
-		switch (WeaponType)
-		{
-		case EWeaponType::EWT_SubmachineGun:
-			WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("SubmachineGun"), TEXT(""));
-			break;
-		case EWeaponType::EWT_AssaultRifle:
-			WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("AssaultRifle"), TEXT(""));
-			break;
-		case EWeaponType::EWT_Pistol:
-			WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("Pistol"), TEXT(""));
-			break;
-		case EWeaponType::EWT_Shotgun:
-			WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("Shotgun"), TEXT(""));
-			break;
-		}
-
-		if (WeaponDataRow)
-		{
-			FireMode			= WeaponDataRow->FireMode;
-			AmmoType			= WeaponDataRow->AmmoType;
-			Ammo				= WeaponDataRow->WeaponAmmo;
-			MagCapacity			= WeaponDataRow->MagCapacity;
-
-			SetPickupSound(WeaponDataRow->PickupSound);
-			SetEquipSound(WeaponDataRow->EquipSound);
-
-			GetItemMesh()->SetSkeletalMesh(WeaponDataRow->ItemMesh);
+	ResolveDefinition();
 
-			SetItemName(WeaponDataRow->ItemName);
+	//Editor worlds have no definitions, their previews read the table row directly
+	const FWeaponDataTable* WeaponData = Definition ? GetWeaponData() : UItemDefinitionSubsystem::FindWeaponRow(WeaponType);
+	if (WeaponData == nullptr) return;
 
-			SetItemIcon(WeaponDataRow->InventoryIcon);
-			SetAmmoIcon(WeaponDataRow->AmmoIcon);
+	//Ammo changes during play, so the mag starts as a copy. Everything else is read through the definition
+	AmmoType			= WeaponData->AmmoType;
+	Ammo				= WeaponData->WeaponAmmo;
+	MagCapacity			= WeaponData->MagCapacity;
 
-			SetMaterialInstance(WeaponDataRow->MaterialInstance);
-
-			PreviousMaterialIndex = GetMaterialIndex();
-			GetItemMesh()->SetMaterial(PreviousMaterialIndex, nullptr);
-			SetMaterialIndex(WeaponDataRow->MaterialIndex);
-
-			SetClipBoneName(WeaponDataRow->ClipBoneName);
-
-			SetReloadMontageSection(WeaponDataRow->ReloadMontageSection);
-
-			GetItemMesh()->SetAnimInstanceClass(WeaponDataRow->AnimBP);
-
-			CrosshairMiddle			= WeaponDataRow->CrosshairMiddle;
-			CrosshairLeft			= WeaponDataRow->CrosshairLeft;
-			CrosshairRight			= WeaponDataRow->CrosshairRight;
-			CrosshairTop			= WeaponDataRow->CrosshairTop;
-			CrosshairBottom			= WeaponDataRow->CrosshairBottom;
-
-			CrosshairDefaultSpread	= WeaponDataRow->CrosshairDefaultSpread;
-			AutoFireRate			= WeaponDataRow->AutoFireRate;
-			MuzzleFlashEffect		= WeaponDataRow->MuzzleFlash;
-			FireSound				= WeaponDataRow->FireSound;
-			BoneToHide				= WeaponDataRow->BoneToHide;
-
-			//Damage = WeaponDataRow->Damage;
-			//HeadshotDamage = WeaponDataRow->HeadshotDamage;			
-		}
-
-		if (GetMaterialInstance())
-		{
-			SetDynamicMaterialInstance(UMaterialInstanceDynamic::Create(GetMaterialInstance(), this));
-			GetDynamicMaterialInstance()->SetVectorParameterValue(TEXT("FresnelColor"), GetGlowColor());
-
-			GetItemMesh()->SetMaterial(GetMaterialIndex(), GetDynamicMaterialInstance());
-			EnableGlowMaterial();
-		}
-	}
+	GetItemMesh()->SetSkeletalMesh(WeaponData->ItemMesh);
+	GetItemMesh()->SetAnimInstanceClass(WeaponData->AnimBP);
 
-	FString WeaponRarityTablePath = TEXT("/Script/Engine.DataTable'/Game/_Game/DataTable/WeaponRarityDataTable.WeaponRarityDataTable'");
-	UDataTable* WeaponRarityTableObject = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *WeaponRarityTablePath));
+	PreviousMaterialIndex = GetMaterialIndex();
+	GetItemMesh()->SetMaterial(PreviousMaterialIndex, nullptr);
+	SetMaterialIndex(WeaponData->MaterialIndex);
 
-	if (WeaponRarityTableObject)
+	if (WeaponData->MaterialInstance)
 	{
-		FString RowName;
-		switch (WeaponType)
-		{
-		case EWeaponType::EWT_SubmachineGun:	RowName = "SMG_";		break;
-		case EWeaponType::EWT_AssaultRifle:		RowName = "AR_";		break;
-		case EWeaponType::EWT_Pistol:			RowName = "Pistol_";	break;
-		case EWeaponType::EWT_Shotgun:			RowName = "Shotgun_";	break;
-		}
+		const FItemRarityTable* RarityRow = FindRarityRow();
 
-		FWeaponRarityDataTable* WeaponRDataRow = nullptr;
-		switch (GetItemRarity())
-		{
-		case EItemRarity::EIR_Damaged:			RowName += "Damaged";	break;
-		case EItemRarity::EIR_Common:			RowName += "Common";	break;
-		case EItemRarity::EIR_Uncommon:			RowName += "UnCommon";	break;
-		case EItemRarity::EIR_Rare:				RowName += "Rare";		break;
-		case EItemRarity::EIR_Legendary:		RowName += "Legendary";	break;
-		}
+		SetDynamicMaterialInstance(UMaterialInstanceDynamic::Create(WeaponData->MaterialInstance, this));
+		GetDynamicMaterialInstance()->SetVectorParameterValue(TEXT("FresnelColor"), RarityRow ? RarityRow->GlowColor : FLinearColor::White);
 
-		WeaponRDataRow = WeaponRarityTableObject->FindRow<FWeaponRarityDataTable>(FName(RowName), TEXT(""));
-		if (WeaponRDataRow)
-		{
-			Damage				= WeaponRDataRow->DamageBody;
-			HeadshotDamage		= WeaponRDataRow->DamageHeadshot;
-			DamageMultiplier	= WeaponRDataRow->DamageMultiplier;
-			Accuracy			= WeaponRDataRow->Accuracy;
-			RecoilPitch			= WeaponRDataRow->RecoilPitch;
-			RecoilYaw			= WeaponRDataRow->RecoilYaw;
-		}
+		GetItemMesh()->SetMaterial(GetMaterialIndex(), GetDynamicMaterialInstance());
+		EnableGlowMaterial();
 	}
 }
 
-bool AWeapon::TraceUnderCrosshair(FHitResult& OutHitResult, FVector& OutHitLocation)
+void AWeapon::ResolveDefinition()
 {
-	if (Character == nullptr) return false;
+	UItemDefinitionSubsystem* ItemDefinitionSubsystem = UItemDefinitionSubsystem::Get(this);
+	Definition = ItemDefinitionSubsystem ? &ItemDefinitionSubsystem->GetWeaponDefinition(WeaponType, GetItemRarity()) : nullptr;
+}
 
-	FVector2D ViewportSixe;
-	if (GEngine && GEngine->GameViewport)
-		GEngine->GameViewport->GetViewportSize(ViewportSixe);
+USoundCue* AWeapon::GetPickupSound() const
+{
+	return GetWeaponData() ? GetWeaponData()->PickupSound.Get() : Super::GetPickupSound();
+}
 
-	FVector2D CrosshairLocation(ViewportSixe.X * 0.5f, ViewportSixe.Y * 0.5f);
+USoundCue* AWeapon::GetEquippedSound() const
+{
+	return GetWeaponData() ? GetWeaponData()->EquipSound.Get() : Super::GetEquippedSound();
+}
 
-	FVector CrosshairWorldPosition;
-	FVector CrosshairWorldDirection;
-	bool bScreenToWorld = UGameplayStatics::DeprojectScreenToWorld(UGameplayStatics::GetPlayerController(this, 0), CrosshairLocation, CrosshairWorldPosition, CrosshairWorldDirection);
-	if (bScreenToWorld)
-	{
-		//Trace from Crosshair World Location Outward
-		float WeaponAccuracy = Character->bAiming ? Accuracy * 0.5f : Accuracy;
-
-		const FVector Start = CrosshairWorldPosition;
-		FVector End = CrosshairWorldPosition + CrosshairWorldDirection * 5000.0f;
-		End.X += FMath::FRandRange(-WeaponAccuracy, WeaponAccuracy);
-		End.Y += FMath::FRandRange(-WeaponAccuracy, WeaponAccuracy);
-		End.Z += FMath::FRandRange(-WeaponAccuracy, WeaponAccuracy);
-
-		OutHitLocation = End;
-		GetWorld()->LineTraceSingleByChannel(OutHitResult, Start, End, ECollisionChannel::ECC_Visibility);
-		if (OutHitResult.bBlockingHit)
-		{
-			OutHitLocation = OutHitResult.Location;
-			return true;
-		}
-	}
+FString AWeapon::GetItemName() const
+{
+	return GetWeaponData() ? GetWeaponData()->ItemName : Super::GetItemName();
+}
 
-	return false;
+UTexture2D* AWeapon::GetItemIcon() const
+{
+	return GetWeaponData() ? GetWeaponData()->InventoryIcon.Get() : Super::GetItemIcon();
 }
 
-bool AWeapon::GetTraceEndLocation(const FVector& MuzzleSocketLocation, FHitResult& OutHitResult)
+UTexture2D* AWeapon::GetAmmoIcon() const
 {
-	FVector OutBeamLocation;
+	return GetWeaponData() ? GetWeaponData()->AmmoIcon.Get() : Super::GetAmmoIcon();
+}
 
-	FHitResult CrosshairHitResult;
-	bool bCrosshairHit = TraceUnderCrosshair(CrosshairHitResult, OutBeamLocation);
+bool AWeapon::GetCrosshairRay(FVector& OutStart, FVector& OutDirection) const
+{
+	if (Character == nullptr) return false;
 
-	//Perform 2nd Trace from Gun Barrel	
-	const FVector WeaponTraceStart = MuzzleSocketLocation;
-	const FVector StartToEnd = OutBeamLocation - MuzzleSocketLocation;
-	const FVector WeaponTraceEnd = OutBeamLocation + StartToEnd * 1.25f;
-	GetWorld()->LineTraceSingleByChannel(OutHitResult, WeaponTraceStart, WeaponTraceEnd, ECollisionChannel::ECC_Visibility);
-	if (!OutHitResult.bBlockingHit)
-	{
-		OutHitResult.Location = OutBeamLocation;
-		return false;
-	}
+	FVector2D ViewportSize;
+	if (GEngine && GEngine->GameViewport)
+		GEngine->GameViewport->GetViewportSize(ViewportSize);
 
-	return true;
+	const FVector2D CrosshairLocation(ViewportSize.X * 0.5f, ViewportSize.Y * 0.5f);
+	return UGameplayStatics::DeprojectScreenToWorld(UGameplayStatics::GetPlayerController(this, 0), CrosshairLocation, OutStart, OutDirection);
 }
 
 void AWeapon::Tick(float DeltaTime)
@@ -242,6 +168,9 @@ void AWeapon::Tick(float DeltaTime)
 
 	if (bMovingSlide && SlideDisplacementCurve)
 		UpdateSlideDisplacement();
+
+	if (bFireScheduled)
+		TickFireSchedule(DeltaTime);
 }
 
 void AWeapon::ThrowWeapon()
@@ -253,7 +182,7 @@ void AWeapon::ThrowWeapon()
 	const FVector MeshForward{ GetItemMesh()->GetRightVector() };
 
 	//Direction in which we throw the weapon
-	float RandomRotation{ FMath::FRandRange(-20.0f, 20.0f) };
+	float RandomRotation{ URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::WeaponStream).FRandRange(-20.0f, 20.0f) };
 
 	FVector ImpulseDir = MeshForward.RotateAngleAxis(RandomRotation, FVector::UpVector);
 	ImpulseDir *= 30.0f;
@@ -268,91 +197,200 @@ void AWeapon::ThrowWeapon()
 
 void AWeapon::Fire()
 {
-	if (Character == nullptr) return;
-	
-	if (Ammo > 0)
-	{
-		Ammo = FMath::Max(--Ammo, 0);
+	if (Character == nullptr || bFireScheduled) return;
+	if (Ammo <= 0) return;
 
-		switch (FireMode)
-		{
-		case EFiringMode::EFM_SemiAuto:
-		case EFiringMode::EFM_Auto:				FireBullet();							break;
-		case EFiringMode::EFM_Shotgun: for (int i = 0; i < 5; i++) { FireBullet(); }	break;
-		}
+	FireRounds(1);
+
+	//The rest of the trigger pull is driven by TickFireSchedule
+	bFireScheduled = true;
+	FireCooldown = GetAutoFireRate();
+	BurstRoundsFired = 1;
+	BurstStartTime = GetWorld()->GetTimeSeconds();
+	BurstStartFrame = GFrameCounter;
 
-		Character->CombatState = ECombatState::ECS_FireTimerInProgress;
-		Character->PlayGunFireMontage();
-		Character->StartCrosshairBulletFire();
-		Character->AddControllerPitchInput(FMath::FRandRange(-RecoilPitch, -RecoilPitch));
-		Character->AddControllerYawInput(FMath::FRandRange(-RecoilYaw, RecoilYaw));
+	Character->CombatState = ECombatState::ECS_FireTimerInProgress;
+}
+
+void AWeapon::FireRounds(int32 Rounds)
+{
+	Ammo = FMath::Max(Ammo - Rounds, 0);
 
-		GetWorldTimerManager().SetTimer(FireTimerHandle, this, &AWeapon::OnFireTimerFinish, AutoFireRate);
+	FireBullets(GetPelletCount() * Rounds);
 
-		UAISense_Hearing::ReportNoiseEvent(this, Character->GetActorLocation(), 0.5f, this, 0.0f);
+	Character->PlayGunFireMontage();
+	Character->StartCrosshairBulletFire();
 
-		if (MuzzleFlashComp) MuzzleFlashComp->Activate(true);
-		if (FireSound) UGameplayStatics::PlaySoundAtLocation(this, FireSound, Character->GetActorLocation());
-		if (WeaponType == EWeaponType::EWT_Pistol) StartSlideTimer();
+	FRandomStream& WeaponStream = URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::WeaponStream);
+	for (int32 i = 0; i < Rounds; i++)
+	{
+		Character->AddControllerPitchInput(WeaponStream.FRandRange(-GetRecoilPitch(), -GetRecoilPitch()));
+		Character->AddControllerYawInput(WeaponStream.FRandRange(-GetRecoilYaw(), GetRecoilYaw()));
 	}
+
+	UAISense_Hearing::ReportNoiseEvent(this, Character->GetActorLocation(), 0.5f, this, 0.0f);
+
+	if (MuzzleFlashComp) MuzzleFlashComp->Activate(true);
+	if (USoundCue* FireSound = GetFireSound()) UAudioVoiceSubsystem::SpawnVoiceAtLocation(this, FireSound, EVoiceCategory::EVC_Fire, Character->GetActorLocation());
+	if (WeaponType == EWeaponType::EWT_Pistol) StartSlideTimer();
+
+	SET_DWORD_STAT(STAT_WeaponRoundsPerFrame, Rounds);
 }
 
-void AWeapon::FireBullet()
+void AWeapon::FireBullets(int32 Count)
 {
-	if (BarrelSocket == nullptr) return;
+	if (BarrelSocket == nullptr || Character == nullptr || Count <= 0) return;
 
+	SCOPE_CYCLE_COUNTER(STAT_WeaponFireBullets);
+
+	FVector CrosshairStart;
+	FVector CrosshairDirection;
+	if (!GetCrosshairRay(CrosshairStart, CrosshairDirection)) return;
+
+	UWorld* World = GetWorld();
 	const FTransform SocketTransform = BarrelSocket->GetSocketTransform(GetItemMesh());
+	const FVector MuzzleLocation = SocketTransform.GetLocation();
+
+	const float WeaponAccuracy = Character->bAiming ? GetAccuracy() * 0.5f : GetAccuracy();
+	FRandomStream& WeaponStream = URandomStreamSubsystem::GetStream(this, URandomStreamSubsystem::WeaponStream);
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WeaponFireTrace));
+	QueryParams.AddIgnoredActor(this);
+	QueryParams.AddIgnoredActor(Character);
 
-	FHitResult TraceHitResult;
-	
-	FBulletHitData BulletHitData;
-	BulletHitData.BodyDamage = Damage;
-	BulletHitData.HeadshotDamage = HeadshotDamage;
-	
-	bool bBeamEnd = GetTraceEndLocation(SocketTransform.GetLocation(), TraceHitResult);
-	if (bBeamEnd)
+	//Trace every pellet first, from the crosshair outward and then from the barrel toward what the crosshair hit
+	TArray<FHitResult, TInlineAllocator<8>> PelletHits;
+	PelletHits.SetNum(Count);
+
+	for (int32 i = 0; i < Count; i++)
+	{
+		FVector End = CrosshairStart + CrosshairDirection * 5000.0f;
+		End.X += WeaponStream.FRandRange(-WeaponAccuracy, WeaponAccuracy);
+		End.Y += WeaponStream.FRandRange(-WeaponAccuracy, WeaponAccuracy);
+		End.Z += WeaponStream.FRandRange(-WeaponAccuracy, WeaponAccuracy);
+
+		FHitResult CrosshairHitResult;
+		const FVector BeamLocation = World->LineTraceSingleByChannel(CrosshairHitResult, CrosshairStart, End, ECC_WeaponTrace, QueryParams) ? CrosshairHitResult.Location : End;
+
+		FHitResult& PelletHit = PelletHits[i];
+		const FVector WeaponTraceEnd = BeamLocation + (BeamLocation - MuzzleLocation) * 1.25f;
+		if (!World->LineTraceSingleByChannel(PelletHit, MuzzleLocation, WeaponTraceEnd, ECC_WeaponTrace, QueryParams))
+			PelletHit.Location = BeamLocation;
+	}
+
+	//Pellets that hit the same actor are applied as one damage event, a headshot pellet is preferred as the reported hit
+	struct FPelletHitGroup
 	{
-		//Does Hit Actor implement Bullet Hit Interface?
-		if (TraceHitResult.GetActor())
+		AActor* Actor;
+		int32 HitIndex;
+		float Damage;
+	};
+	TArray<FPelletHitGroup, TInlineAllocator<8>> HitGroups;
+
+	for (int32 i = 0; i < Count; i++)
+	{
+		const FHitResult& PelletHit = PelletHits[i];
+		AActor* HitActor = PelletHit.GetActor();
+		if (!PelletHit.bBlockingHit || HitActor == nullptr) continue;
+
+		if (Cast<IDamageable>(HitActor) == nullptr)
 		{
-			if (auto DamageableActor = Cast<IDamageable>(TraceHitResult.GetActor()))
-				DamageableActor->ProcessDamage_Implementation(TraceHitResult, Damage, Character, Character->GetController());
-			else
-			{
-				if (BulletWallHitEffect != nullptr)
-					UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BulletWallHitEffect, TraceHitResult.Location);
-			}
+			if (BulletWallHitEffect != nullptr)
+				UFXPoolSubsystem::SpawnEffect(this, BulletWallHitEffect, EFXCategory::EFXC_Impact, PelletHit.Location);
+			continue;
 		}
+
+		//Enemies pick body or headshot damage and the zone multiplier from the body the pellet hit
+		const AEnemy* HitEnemy = Cast<AEnemy>(HitActor);
+		const float PelletDamage = HitEnemy ? HitEnemy->ResolveHitDamage(PelletHit, Definition->Stats.DamageBody, Definition->Stats.DamageHeadshot) : Definition->Stats.DamageBody;
+
+		FPelletHitGroup* HitGroup = HitGroups.FindByPredicate([HitActor](const FPelletHitGroup& Group) { return Group.Actor == HitActor; });
+		if (HitGroup == nullptr)
+		{
+			HitGroups.Add({ HitActor, i, PelletDamage });
+			continue;
+		}
+
+		HitGroup->Damage += PelletDamage;
+
+		if (HitEnemy && HitEnemy->GetHitZone(PelletHit) == EHitZone::EHZ_Head)
+			HitGroup->HitIndex = i;
+	}
+
+	for (const FPelletHitGroup& HitGroup : HitGroups)
+	{
+		if (auto DamageableActor = Cast<IDamageable>(HitGroup.Actor))
+			DamageableActor->ProcessDamage_Implementation(PelletHits[HitGroup.HitIndex], HitGroup.Damage, Character, Character->GetController());
 	}
 
 	if (BeamParticleEffect != nullptr)
 	{
-		UParticleSystemComponent* Beam = UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BeamParticleEffect, SocketTransform);
-		if (Beam != nullptr)
-			Beam->SetVectorParameter(FName("Target"), TraceHitResult.Location);
+		const FRotator SocketRotation = SocketTransform.Rotator();
+		for (const FHitResult& PelletHit : PelletHits)
+		{
+			UParticleSystemComponent* Beam = UFXPoolSubsystem::SpawnEffect(this, BeamParticleEffect, EFXCategory::EFXC_Beam, MuzzleLocation, SocketRotation);
+			if (Beam != nullptr)
+				Beam->SetVectorParameter(FName("Target"), PelletHit.Location);
+		}
 	}
 }
 
-void AWeapon::OnFireTimerFinish()
+void AWeapon::TickFireSchedule(float DeltaTime)
 {
-	if (Character == nullptr ) return;
-	if (Character->CombatState == ECombatState::ECS_Stunned) return;
+	//The frame time leading up to the first round is not owed to the schedule
+	if (GFrameCounter == BurstStartFrame) return;
 
-	Character->CombatState = ECombatState::ECS_Unoccupied;
+	FireCooldown -= DeltaTime;
+	if (FireCooldown > 0.0f) return;
 
-	if (Ammo > 0)
+	if (Character == nullptr)
 	{
-		if (Character->GetShooterController()->IsFireButtonHeld())
-		{
-			switch (FireMode)
-			{
-				case EFiringMode::EFM_SemiAuto:				break;
-				case EFiringMode::EFM_Auto:
-				case EFiringMode::EFM_Shotgun:	Fire();		break;
-			}
-		}
+		bFireScheduled = false;
+		return;
+	}
+
+	//A stun takes over the combat state, the trigger pull simply ends
+	if (Character->CombatState == ECombatState::ECS_Stunned)
+	{
+		bFireScheduled = false;
+		return;
+	}
+
+	const bool bAutomatic = GetFireMode() == EFiringMode::EFM_Auto || GetFireMode() == EFiringMode::EFM_Shotgun;
+	if (!bAutomatic || Ammo <= 0 || !Character->GetShooterController()->IsFireButtonHeld())
+	{
+		StopFireSchedule();
+		return;
 	}
-	else
+
+	//Every whole interval that elapsed since the round was due owes one more round
+	const float FireRate = FMath::Max(GetAutoFireRate(), KINDA_SMALL_NUMBER);
+	const int32 RoundsOwed = 1 + FMath::FloorToInt(-FireCooldown / FireRate);
+	const int32 Rounds = FMath::Min3(RoundsOwed, Ammo, FMath::Max(MaxRoundsPerFrame, 1));
+
+	FireCooldown = FMath::Max(FireCooldown + Rounds * FireRate, 0.0f);
+
+	FireRounds(Rounds);
+
+	BurstRoundsFired += Rounds;
+	const double BurstTime = GetWorld()->GetTimeSeconds() - BurstStartTime;
+	if (BurstTime > 0.0)
+		AchievedRoundsPerMinute = (float)((BurstRoundsFired - 1) * 60.0 / BurstTime);
+
+	SET_FLOAT_STAT(STAT_WeaponAchievedRPM, AchievedRoundsPerMinute);
+	SET_FLOAT_STAT(STAT_WeaponNominalRPM, GetNominalRoundsPerMinute());
+}
+
+void AWeapon::StopFireSchedule()
+{
+	bFireScheduled = false;
+	FireCooldown = 0.0f;
+
+	if (BurstRoundsFired > 1)
+		UE_LOG(LogGunBound, Verbose, TEXT("%s fired %d rounds at %.0f RPM (nominal %.0f)"), *GetName(), BurstRoundsFired, AchievedRoundsPerMinute, GetNominalRoundsPerMinute());
+
+	Character->CombatState = ECombatState::ECS_Unoccupied;
+
+	if (Ammo <= 0)
 		Character->ReloadWeapon();
 }
 
@@ -375,8 +413,6 @@ void AWeapon::StopFalling()
 {
 	bFalling = false;
 	SetItemState(EItemState::EIS_Pickup);
-
-	StartPulseTimer();
 }
 
 void AWeapon::UpdateSlideDisplacement()
@@ -128,6 +128,10 @@ struct FWeaponDataTable : public FTableRowBase
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float AutoFireRate;
 
+	//Pellets per shot, 0 uses the fire mode default
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 PelletCount;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TObjectPtr<UParticleSystem> MuzzleFlash;
 
@@ -160,12 +164,41 @@ struct FWeaponDataTable : public FTableRowBase
 		CrosshairBottom(nullptr),
 		CrosshairDefaultSpread(0.5f),
 		AutoFireRate(0.1f),
+		PelletCount(0),
 		MuzzleFlash(nullptr),
 		FireSound(nullptr),
 		BoneToHide(NAME_None)
 	{}
 };
 
+//Immutable weapon type and rarity data, built once by UItemDefinitionSubsystem and shared by every weapon of that kind
+USTRUCT()
+struct FWeaponDefinition
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EWeaponType WeaponType;
+
+	UPROPERTY()
+	EItemRarity Rarity;
+
+	UPROPERTY()
+	FWeaponDataTable Data;
+
+	UPROPERTY()
+	FWeaponRarityDataTable Stats;
+
+	//False when WeaponDataTable has no row for WeaponType, Data then holds the row defaults
+	bool bHasData;
+
+	FWeaponDefinition() :
+		WeaponType(EWeaponType::EWT_SubmachineGun),
+		Rarity(EItemRarity::EIR_Common),
+		bHasData(false)
+	{}
+};
+
 UCLASS()
 class STEPHEN_TP_SHOOTER_API AWeapon : public AItem
 {
@@ -179,20 +212,28 @@ public:
 	virtual void Tick(float DeltaTime) override;
 
 private:
-	UFUNCTION()
-	void OnFireTimerFinish();
+	//Fires every round owed since the last frame, ends the schedule once the trigger is released
+	void TickFireSchedule(float DeltaTime);
+
+	//Leaves the firing state, reloading when the mag is empty
+	void StopFireSchedule();
+
+	//Fires Rounds rounds at once, their pellets are traced in a single batch
+	void FireRounds(int32 Rounds);
 
 	UFUNCTION()
 	void StopFalling();
 
 	void UpdateSlideDisplacement();
 
-	bool TraceUnderCrosshair(FHitResult& OutHitResult, FVector& OutHitLocation);
-	bool GetTraceEndLocation(const FVector& MuzzleSocketLocation, FHitResult& OutHitResult);
+	//Points Definition at the shared entry for WeaponType and ItemRarity, left null in editor worlds
+	void ResolveDefinition();
 
-	//Type of Firing Mode of the weapon
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	EFiringMode FireMode;
+	//Table row of WeaponType, null when the table has none
+	FORCEINLINE const FWeaponDataTable* GetWeaponData() const { return Definition && Definition->bHasData ? &Definition->Data : nullptr; }
+
+	//Deprojects the screen center once per shot, every pellet jitters around this ray
+	bool GetCrosshairRay(FVector& OutStart, FVector& OutDirection) const;
 
 	//Ammo Count for this weapon
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
@@ -225,34 +266,6 @@ private:
 	//Index of Previous Dynamic Material so that it can be cleared when WeaponType is changed and a new Dynamic Material Index is created
 	int32 PreviousMaterialIndex;
 
-	//Centered Crosshair Texture
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UTexture2D> CrosshairMiddle;
-
-	//Left side Crosshair Texture
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UTexture2D> CrosshairLeft;
-
-	//Right side Crosshair Texture
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UTexture2D> CrosshairRight;
-
-	//Top side Crosshair Texture
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UTexture2D> CrosshairTop;
-
-	//Bottom side Crosshair Texture
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UTexture2D> CrosshairBottom;
-
-	//Firing Rate of Weapon when firing mode is set to EFiringMode::EFM_Auto
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	float AutoFireRate;
-
-	//Play Firing Particle Effects
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UParticleSystem> MuzzleFlashEffect;
-
 	//Firing Particle Effects Component
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UParticleSystemComponent> MuzzleFlashComp;
@@ -263,14 +276,6 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UParticleSystem> BulletWallHitEffect;
 
-	//Plays Fire Sound when firing
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<USoundCue> FireSound;
-
-	//Name of bone to hide part of weapon mesh
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	FName BoneToHide;
-
 	//Amount that the slide is pushed during pistol fire
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Pistol Properties", meta = (AllowPrivateAccess = "true"))
 	float SlideDisplacement;
@@ -299,49 +304,41 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Pistol Properties", meta = (AllowPrivateAccess = "true"))
 	float RecoilRotation;
 
-	//Normal Body damage when hit something
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	float Damage;
+	FTimerHandle ThrowWeaponTimer;
+	float ThrowWeaponTime;
+	bool bFalling;
 
-	//Normal Body damage when hit something
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	float DamageMultiplier;
+	//Seconds until the next round is due, the remainder carries over so the fire rate does not depend on frame time
+	float FireCooldown;
 
-	//Headshot Damage when hit in head
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	float HeadshotDamage;
+	//True from the first round of a trigger pull until the last round's cooldown has elapsed
+	bool bFireScheduled;
 
-	//Headshot Damage when hit in head
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	float CrosshairDefaultSpread;
+	//Rounds fired, world time and frame of the first round of the current trigger pull
+	int32 BurstRoundsFired;
+	double BurstStartTime;
+	uint64 BurstStartFrame;
 
-	//Accuracy of Weapon
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	float Accuracy;
+	//Rate of fire measured over the current or last trigger pull
+	float AchievedRoundsPerMinute;
 
-	//Up/Down Axis Recoil when firing
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	float RecoilPitch;
-
-	//Left/Right Axis Recoil when firing
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
-	float RecoilYaw;
-
-	FTimerHandle ThrowWeaponTimer;
-	float ThrowWeaponTime;
-	bool bFalling;
-
-	FTimerHandle FireTimerHandle;
+	//Most rounds fired in one frame, a long hitch forgives the rest instead of emptying the mag at once
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
+	int32 MaxRoundsPerFrame;
 
 	//Timer Handle for Updating Pistol Slide Displacement
 	FTimerHandle SlideTimer;
 
 	const USkeletalMeshSocket* BarrelSocket;
 
+	//Shared firing, damage and effect data for this weapon type and rarity, owned by UItemDefinitionSubsystem.
+	//Resolved in OnConstruction and BeginPlay, never null once the weapon is in play
+	const FWeaponDefinition* Definition;
+
 public:
 	void ThrowWeapon();
 	void Fire();
-	void FireBullet();
+	void FireBullets(int32 Count);
 	void ReloadAmmo(int32 Amount);
 	void StartSlideTimer();
 
@@ -359,23 +356,79 @@ public:
 	FORCEINLINE EWeaponType GetWeaponType() const { return WeaponType; }
 	FORCEINLINE EAmmoType GetAmmoType() const { return AmmoType; }
 
-	FORCEINLINE FName GetReloadMontageSection() const { return ReloadMontageSection; }
+	//The properties are only used by weapon types missing from the weapon table
+	FORCEINLINE FName GetReloadMontageSection() const { return GetWeaponData() ? GetWeaponData()->ReloadMontageSection : ReloadMontageSection; }
 	FORCEINLINE void SetReloadMontageSection(const FName& NewMontageSection) { ReloadMontageSection = NewMontageSection; }
 
-	FORCEINLINE FName GetClipBoneName() const { return ClipBoneName; }
+	FORCEINLINE FName GetClipBoneName() const { return GetWeaponData() ? GetWeaponData()->ClipBoneName : ClipBoneName; }
 	FORCEINLINE void SetClipBoneName(const FName& NewBoneName) { ClipBoneName = NewBoneName; }
 
 	FORCEINLINE bool GetMovingClip() const { return bMovingClip; }
 	FORCEINLINE void SetMovingClip(const bool& move) { bMovingClip = move; }
 
-	FORCEINLINE float GetCrosshairDefaultSpread() const { return CrosshairDefaultSpread; }
-	FORCEINLINE float GetAutoFireRate() const { return AutoFireRate; }
-	
-	FORCEINLINE TObjectPtr<USoundCue> GetFireSound() const { return FireSound; }
+	virtual USoundCue* GetPickupSound() const override;
+	virtual USoundCue* GetEquippedSound() const override;
+	virtual FString GetItemName() const override;
+	virtual UTexture2D* GetItemIcon() const override;
+	virtual UTexture2D* GetAmmoIcon() const override;
+
+	//Definition getters return neutral values until the weapon is constructed, the class default and archetypes never resolve one
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE EFiringMode GetFireMode() const { return Definition ? Definition->Data.FireMode : EFiringMode::EFM_SemiAuto; }
+
+	FORCEINLINE float GetCrosshairDefaultSpread() const { return Definition ? Definition->Data.CrosshairDefaultSpread : 0.0f; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE float GetAutoFireRate() const { return Definition ? Definition->Data.AutoFireRate : 0.0f; }
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE float GetAchievedRoundsPerMinute() const { return AchievedRoundsPerMinute; }
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE float GetNominalRoundsPerMinute() const { return GetAutoFireRate() > 0.0f ? 60.0f / GetAutoFireRate() : 0.0f; }
+	FORCEINLINE int32 GetPelletCount() const { return Definition && Definition->Data.PelletCount > 0 ? Definition->Data.PelletCount : (GetFireMode() == EFiringMode::EFM_Shotgun ? 5 : 1); }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE UParticleSystem* GetMuzzleFlashEffect() const { return Definition ? Definition->Data.MuzzleFlash.Get() : nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE USoundCue* GetFireSound() const { return Definition ? Definition->Data.FireSound.Get() : nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE FName GetBoneToHide() const { return Definition ? Definition->Data.BoneToHide : NAME_None; }
+
 	FORCEINLINE const USkeletalMeshSocket* GetBarrelSocket() const { return BarrelSocket; }
 
-	FORCEINLINE float GetDamage() const { return Damage * DamageMultiplier; }
-	FORCEINLINE float GetHeadshotDamage() const { return HeadshotDamage * DamageMultiplier; }
-	FORCEINLINE float GetDamageMultiplier() const { return DamageMultiplier; }
-	FORCEINLINE float GetAccuracy() const { return Accuracy; }
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE UTexture2D* GetCrosshairMiddle() const { return Definition ? Definition->Data.CrosshairMiddle.Get() : nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE UTexture2D* GetCrosshairLeft() const { return Definition ? Definition->Data.CrosshairLeft.Get() : nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE UTexture2D* GetCrosshairRight() const { return Definition ? Definition->Data.CrosshairRight.Get() : nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE UTexture2D* GetCrosshairTop() const { return Definition ? Definition->Data.CrosshairTop.Get() : nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE UTexture2D* GetCrosshairBottom() const { return Definition ? Definition->Data.CrosshairBottom.Get() : nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE float GetDamage() const { return Definition ? Definition->Stats.DamageBody * Definition->Stats.DamageMultiplier : 0.0f; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE float GetHeadshotDamage() const { return Definition ? Definition->Stats.DamageHeadshot * Definition->Stats.DamageMultiplier : 0.0f; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE float GetDamageMultiplier() const { return Definition ? Definition->Stats.DamageMultiplier : 1.0f; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE float GetAccuracy() const { return Definition ? Definition->Stats.Accuracy : 0.0f; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE float GetRecoilPitch() const { return Definition ? Definition->Stats.RecoilPitch : 0.0f; }
+
+	UFUNCTION(BlueprintPure, Category = "Weapon Properties")
+	FORCEINLINE float GetRecoilYaw() const { return Definition ? Definition->Stats.RecoilYaw : 0.0f; }
 };